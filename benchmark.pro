@@ -0,0 +1,25 @@
+######################################################################
+# Benchmarks, built without qt
+######################################################################
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= qt
+DESTDIR = release
+OBJECTS_DIR = release/.obj-benchmark
+TARGET = earthgen-benchmark
+include(core.pri)
+DEPENDPATH += source/benchmark source/cli
+
+# Input
+HEADERS += source/benchmark/benchmarks.h \
+           source/cli/options.h \
+           source/cli/timer.h
+SOURCES += source/benchmark/main.cpp \
+           source/benchmark/point_location_benchmark.cpp \
+           source/benchmark/season_codec_benchmark.cpp \
+           source/benchmark/concurrent_generation_benchmark.cpp \
+           source/benchmark/batch_math_benchmark.cpp \
+           source/benchmark/fast_math_benchmark.cpp \
+           source/benchmark/stage_benchmark.cpp \
+           source/cli/options.cpp
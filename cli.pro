@@ -0,0 +1,26 @@
+######################################################################
+# Command line tools, built without qt
+######################################################################
+
+TEMPLATE = app
+CONFIG += console
+CONFIG -= qt
+DESTDIR = release
+OBJECTS_DIR = release/.obj-cli
+TARGET = earthgen-cli
+include(core.pri)
+DEPENDPATH += source/cli
+
+# Input
+HEADERS += source/cli/commands.h \
+           source/cli/options.h \
+           source/cli/timer.h
+SOURCES += source/cli/main.cpp \
+           source/cli/options.cpp \
+           source/cli/render_command.cpp \
+           source/cli/animate_command.cpp \
+           source/cli/export_command.cpp \
+           source/cli/raster_command.cpp \
+           source/cli/batch_command.cpp \
+           source/cli/golden_command.cpp \
+           source/cli/memory_command.cpp
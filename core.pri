@@ -0,0 +1,135 @@
+######################################################################
+# Planet generation and software rendering, shared by the qt-free tools
+######################################################################
+
+QMAKE_CXXFLAGS += -std=c++0x -pthread
+LIBS += -pthread
+DEPENDPATH += . \
+              source \
+              source/hash \
+              source/io \
+              source/math \
+              source/planet \
+              source/render \
+              source/thread \
+              source/planet/climate \
+              source/planet/grid \
+              source/planet/terrain
+INCLUDEPATH += . \
+               source/math \
+               source/planet \
+               source/planet/grid \
+               source/planet/terrain \
+               source/planet/climate \
+               source/render \
+               source/hash
+
+HEADERS += source/hash/md5.h \
+           source/io/png.h \
+           source/io/planet_file.h \
+           source/io/column_export.h \
+           source/io/season_codec.h \
+           source/io/raster_export.h \
+           source/math/math_common.h \
+           source/math/matrix2.h \
+           source/math/matrix3.h \
+           source/math/quaternion.h \
+           source/math/vector2.h \
+           source/math/vector3.h \
+           source/math/counter_rng.h \
+           source/math/batch_math.h \
+           source/math/fast_math.h \
+           source/planet/planet.h \
+           source/planet/planet_cache.h \
+           source/planet/planet_digest.h \
+           source/planet/planet_memory.h \
+           source/planet/generation_context.h \
+           source/render/colour.h \
+           source/render/colour_palette.h \
+           source/render/grid_vectors.h \
+           source/render/hammer_projection.h \
+           source/render/hammer_tile.h \
+           source/render/image.h \
+           source/render/planet_colours.h \
+           source/render/software_renderer.h \
+           source/thread/parallel.h \
+           source/thread/thread_pool.h \
+           source/thread/task_scheduler.h \
+           source/planet/climate/climate.h \
+           source/planet/climate/climate_corner.h \
+           source/planet/climate/climate_edge.h \
+           source/planet/climate/climate_generation.h \
+           source/planet/climate/climate_generation_season.h \
+           source/planet/climate/climate_parameters.h \
+           source/planet/climate/climate_tile.h \
+           source/planet/climate/climate_variables.h \
+           source/planet/climate/season.h \
+           source/planet/climate/season_variables.h \
+           source/planet/climate/wind.h \
+           source/planet/grid/corner.h \
+           source/planet/grid/create_grid.h \
+           source/planet/grid/edge.h \
+           source/planet/grid/grid.h \
+           source/planet/grid/tile.h \
+           source/planet/grid/tile_locator.h \
+           source/planet/grid/grid_cache.h \
+           source/planet/terrain/river.h \
+           source/planet/terrain/terrain.h \
+           source/planet/terrain/terrain_corner.h \
+           source/planet/terrain/terrain_edge.h \
+           source/planet/terrain/terrain_generation.h \
+           source/planet/terrain/terrain_parameters.h \
+           source/planet/terrain/terrain_tile.h \
+           source/planet/terrain/terrain_variables.h \
+           source/planet/terrain/terrain_water.h
+SOURCES += source/hash/md5.cpp \
+           source/io/png.cpp \
+           source/io/planet_file.cpp \
+           source/io/column_export.cpp \
+           source/io/season_codec.cpp \
+           source/io/raster_export.cpp \
+           source/math/matrix2.cpp \
+           source/math/matrix3.cpp \
+           source/math/quaternion.cpp \
+           source/math/vector2.cpp \
+           source/math/vector3.cpp \
+           source/math/counter_rng.cpp \
+           source/math/batch_math.cpp \
+           source/math/fast_math.cpp \
+           source/planet/planet.cpp \
+           source/planet/planet_cache.cpp \
+           source/planet/planet_digest.cpp \
+           source/planet/planet_memory.cpp \
+           source/planet/generation_context.cpp \
+           source/render/colour.cpp \
+           source/render/colour_palette.cpp \
+           source/render/grid_vectors.cpp \
+           source/render/hammer_projection.cpp \
+           source/render/hammer_tile.cpp \
+           source/render/image.cpp \
+           source/render/planet_colours.cpp \
+           source/render/software_renderer.cpp \
+           source/thread/parallel.cpp \
+           source/thread/thread_pool.cpp \
+           source/thread/task_scheduler.cpp \
+           source/planet/climate/climate.cpp \
+           source/planet/climate/climate_corner.cpp \
+           source/planet/climate/climate_edge.cpp \
+           source/planet/climate/climate_generation.cpp \
+           source/planet/climate/climate_tile.cpp \
+           source/planet/climate/climate_variables.cpp \
+           source/planet/climate/season.cpp \
+           source/planet/grid/corner.cpp \
+           source/planet/grid/create_grid.cpp \
+           source/planet/grid/edge.cpp \
+           source/planet/grid/grid.cpp \
+           source/planet/grid/tile.cpp \
+           source/planet/grid/tile_locator.cpp \
+           source/planet/grid/grid_cache.cpp \
+           source/planet/terrain/river.cpp \
+           source/planet/terrain/terrain.cpp \
+           source/planet/terrain/terrain_corner.cpp \
+           source/planet/terrain/terrain_edge.cpp \
+           source/planet/terrain/terrain_generation.cpp \
+           source/planet/terrain/terrain_tile.cpp \
+           source/planet/terrain/terrain_variables.cpp
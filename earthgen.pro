@@ -4,7 +4,8 @@
 
 TEMPLATE = app
 config += qt console
-QMAKE_CXXFLAGS += -std=c++0x
+QMAKE_CXXFLAGS += -std=c++0x -pthread
+LIBS += -pthread
 QT += opengl
 DESTDIR = release
 OBJECTS_DIR = release/.obj
@@ -13,9 +14,11 @@ DEPENDPATH += . \
               source \
               source/gui \
               source/hash \
+              source/io \
               source/math \
               source/planet \
               source/render \
+              source/thread \
               source/planet/climate \
               source/planet/grid \
               source/planet/terrain \
@@ -40,6 +43,8 @@ HEADERS += source/gui/axisBox.h \
            source/gui/planetWidget.h \
            source/gui/terrainBox.h \
            source/gui/util.h \
+           source/gui/fileBox.h \
+           source/gui/generationBox.h \
            source/hash/md5.h \
            source/math/math_common.h \
            source/math/matrix2.h \
@@ -47,10 +52,18 @@ HEADERS += source/gui/axisBox.h \
            source/math/quaternion.h \
            source/math/vector2.h \
            source/math/vector3.h \
+           source/math/counter_rng.h \
+           source/math/batch_math.h \
+           source/math/fast_math.h \
            source/planet/planet.h \
+           source/planet/planet_cache.h \
+           source/planet/planet_memory.h \
+           source/planet/generation_context.h \
            source/render/colour.h \
+           source/render/colour_palette.h \
            source/render/empty_renderer.h \
            source/render/globe_renderer.h \
+           source/render/grid_vectors.h \
            source/render/hammer_projection.h \
            source/render/hammer_tile.h \
            source/render/map_projection.h \
@@ -58,6 +71,10 @@ HEADERS += source/gui/axisBox.h \
            source/render/planet_colours.h \
            source/render/planet_renderer.h \
            source/render/river_geometry.h \
+           source/render/image.h \
+           source/render/software_renderer.h \
+           source/render/render_statistics.h \
+           source/render/season_animation.h \
            source/planet/climate/climate.h \
            source/planet/climate/climate_corner.h \
            source/planet/climate/climate_edge.h \
@@ -74,6 +91,8 @@ HEADERS += source/gui/axisBox.h \
            source/planet/grid/edge.h \
            source/planet/grid/grid.h \
            source/planet/grid/tile.h \
+           source/planet/grid/tile_locator.h \
+           source/planet/grid/grid_cache.h \
            source/planet/terrain/river.h \
            source/planet/terrain/terrain.h \
            source/planet/terrain/terrain_corner.h \
@@ -83,7 +102,10 @@ HEADERS += source/gui/axisBox.h \
            source/planet/terrain/terrain_tile.h \
            source/planet/terrain/terrain_variables.h \
            source/planet/terrain/terrain_water.h \
-           source/render/render_data/planet_render_data.h
+           source/render/render_data/planet_render_data.h \
+           source/thread/parallel.h \
+           source/io/planet_file.h \
+           source/io/season_codec.h
 SOURCES += source/main.cpp \
            source/gui/axisBox.cpp \
            source/gui/climateBox.cpp \
@@ -94,20 +116,35 @@ SOURCES += source/main.cpp \
            source/gui/planetWidget.cpp \
            source/gui/terrainBox.cpp \
            source/gui/util.cpp \
+           source/gui/fileBox.cpp \
+           source/gui/generationBox.cpp \
            source/hash/md5.cpp \
            source/math/matrix2.cpp \
            source/math/matrix3.cpp \
            source/math/quaternion.cpp \
            source/math/vector2.cpp \
            source/math/vector3.cpp \
+           source/math/counter_rng.cpp \
+           source/math/batch_math.cpp \
+           source/math/fast_math.cpp \
            source/planet/planet.cpp \
+           source/planet/planet_cache.cpp \
+           source/planet/planet_memory.cpp \
+           source/planet/generation_context.cpp \
            source/render/colour.cpp \
+           source/render/colour_palette.cpp \
            source/render/globe_renderer.cpp \
+           source/render/grid_vectors.cpp \
            source/render/hammer_projection.cpp \
            source/render/hammer_tile.cpp \
            source/render/map_renderer.cpp \
            source/render/planet_colours.cpp \
            source/render/planet_renderer.cpp \
+           source/render/image.cpp \
+           source/render/software_renderer.cpp \
+           source/render/render_statistics.cpp \
+           source/render/season_animation.cpp \
+           source/thread/parallel.cpp \
            source/planet/climate/climate.cpp \
            source/planet/climate/climate_corner.cpp \
            source/planet/climate/climate_edge.cpp \
@@ -120,10 +157,14 @@ SOURCES += source/main.cpp \
            source/planet/grid/edge.cpp \
            source/planet/grid/grid.cpp \
            source/planet/grid/tile.cpp \
+           source/planet/grid/tile_locator.cpp \
+           source/planet/grid/grid_cache.cpp \
            source/planet/terrain/river.cpp \
            source/planet/terrain/terrain.cpp \
            source/planet/terrain/terrain_corner.cpp \
            source/planet/terrain/terrain_edge.cpp \
            source/planet/terrain/terrain_generation.cpp \
            source/planet/terrain/terrain_tile.cpp \
-           source/planet/terrain/terrain_variables.cpp
+           source/planet/terrain/terrain_variables.cpp \
+           source/io/planet_file.cpp \
+           source/io/season_codec.cpp
@@ -0,0 +1,77 @@
+#include "benchmarks.h"
+#include "../cli/options.h"
+#include "../cli/timer.h"
+#include "../math/batch_math.h"
+#include "../math/matrix3.h"
+#include "../math/quaternion.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// nanoseconds per element of the fastest of several runs
+double _fastest (int runs, int count, const std::function<void ()>& f) {
+	double best = 1.0e30;
+	for (int i=0; i<runs; i++) {
+		Time_point start = now();
+		f();
+		best = std::min(best, seconds_since(start));
+	}
+	return best / count * 1.0e9;
+}
+
+void _report (const std::string& name, double scalar, double batch) {
+	std::cout << "  " << name << ": " << scalar << " ns scalar, " << batch << " ns batch, " << scalar / batch << "x\n";
+}
+
+void batch_math_benchmark (const Options& o) {
+	int count = int_option(o, "count", 1000000);
+	int runs = int_option(o, "runs", 10);
+	std::mt19937 random(1);
+	std::normal_distribution<float> gaussian;
+	std::vector<Vector3> points(count), others(count), results(count);
+	Vector3_array a, b, out;
+	resize(a, count);
+	resize(b, count);
+	resize(out, count);
+	for (int i=0; i<count; i++) {
+		points[i] = Vector3(gaussian(random), gaussian(random), gaussian(random));
+		others[i] = Vector3(gaussian(random), gaussian(random), gaussian(random));
+		set(a, i, points[i]);
+		set(b, i, others[i]);
+	}
+	Matrix3 m = matrix3(normal(Quaternion(0.9, 0.1, -0.3, 0.2)));
+	std::vector<float> dots(count);
+	double error = 0;
+
+	std::cout << count << " vectors, " << (batch_math_simd() ? "sse" : "scalar fallback") << "\n";
+	double scalar = _fastest(runs, count, [&] () {
+		for (int i=0; i<count; i++)
+			results[i] = m * points[i];
+	});
+	double batch = _fastest(runs, count, [&] () {transform(m, a, out, 0, count);});
+	for (int i=0; i<count; i++)
+		error = std::max(error, length(results[i] - get(out, i)));
+	_report("transform", scalar, batch);
+
+	scalar = _fastest(runs, count, [&] () {
+		for (int i=0; i<count; i++)
+			results[i] = normal(points[i]);
+	});
+	batch = _fastest(runs, count, [&] () {
+		out = a;
+		normalize(out, 0, count);
+	});
+	for (int i=0; i<count; i++)
+		error = std::max(error, length(results[i] - get(out, i)));
+	_report("normalize", scalar, batch);
+
+	scalar = _fastest(runs, count, [&] () {
+		for (int i=0; i<count; i++)
+			dots[i] = dot_product(points[i], others[i]);
+	});
+	batch = _fastest(runs, count, [&] () {dot_products(a, b, dots, 0, count);});
+	_report("dot product", scalar, batch);
+	std::cout << "largest difference from the scalar functions: " << error << "\n";
+}
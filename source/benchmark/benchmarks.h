@@ -0,0 +1,20 @@
+#ifndef benchmarks_h
+#define benchmarks_h
+
+class Options;
+
+// lookups per second of Tile_locator against a linear scan
+void point_location_benchmark (const Options&);
+// compression ratio, error and decode time of the season codec
+void season_codec_benchmark (const Options&);
+// planets per hour generating one planet at a time against one per thread
+void concurrent_generation_benchmark (const Options&);
+// batch vector operations against the Vector3 and Matrix3 functions
+void batch_math_benchmark (const Options&);
+// throughput of the fast_math approximations, false if an error exceeds its documented bound
+bool fast_math_benchmark (const Options&);
+// seconds of every generation and rendering stage across grid sizes, iterations and season counts,
+// one json object per line
+void stage_benchmark (const Options&);
+
+#endif
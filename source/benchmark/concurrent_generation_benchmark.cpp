@@ -0,0 +1,79 @@
+#include "benchmarks.h"
+#include "../cli/options.h"
+#include "../cli/timer.h"
+#include "../planet/planet.h"
+#include "../planet/generation_context.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../thread/thread_pool.h"
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+double _elevation_sum (const Planet& p) {
+	double sum = 0;
+	for (const Terrain_tile& t : tiles(terrain(p)))
+		sum += elevation(t);
+	return sum;
+}
+
+void _generate (Generation_context& c, const Terrain_parameters& terrain, const Climate_parameters& climate, double& checksum) {
+	Planet planet;
+	generate_terrain(planet, terrain, c);
+	generate_climate(planet, climate, c);
+	checksum = _elevation_sum(planet);
+}
+
+void concurrent_generation_benchmark (const Options& o) {
+	Terrain_parameters terrain = terrain_parameters(o);
+	terrain.grid_size = int_option(o, "size", 6);
+	Climate_parameters climate = climate_parameters(o);
+	climate.seasons = int_option(o, "seasons", 2);
+	int planets = int_option(o, "planets", 8);
+	std::vector<Terrain_parameters> seeds(planets, terrain);
+	for (int i=0; i<planets; i++) {
+		std::ostringstream seed;
+		seed << terrain.seed << i;
+		seeds[i].seed = seed.str();
+	}
+
+	// one planet at a time, each using every core for its loops
+	std::vector<double> sequential_sums(planets);
+	std::map<std::string, double> stages;
+	Time_point start = now();
+	for (int i=0; i<planets; i++) {
+		Generation_context c;
+		_generate(c, seeds[i], climate, sequential_sums[i]);
+		for (const Generation_stage& s : c.stages)
+			stages[s.name] += s.seconds;
+	}
+	double sequential = seconds_since(start);
+
+	// one planet per worker, each generated serially with its own context
+	std::vector<double> concurrent_sums(planets);
+	Thread_pool pool(int_option(o, "threads", 0));
+	start = now();
+	for (int i=0; i<planets; i++)
+		submit(pool, [&, i]() {
+			Generation_context c;
+			c.threads = 1;
+			_generate(c, seeds[i], climate, concurrent_sums[i]);
+		});
+	wait(pool);
+	double concurrent = seconds_since(start);
+
+	int mismatches = 0;
+	for (int i=0; i<planets; i++)
+		if (sequential_sums[i] != concurrent_sums[i])
+			mismatches++;
+
+	std::cout << "grid size " << terrain.grid_size << ", " << climate.seasons << " seasons, " << planets << " planets\n";
+	for (auto& s : stages)
+		std::cout << "  " << s.first << ": " << s.second / planets << " s per planet\n";
+	std::cout
+		<< "one at a time: " << planets / sequential * 3600 << " planets per hour\n"
+		<< worker_count(pool) << " concurrent: " << planets / concurrent * 3600 << " planets per hour\n"
+		<< "planets differing between the two: " << mismatches << "\n";
+}
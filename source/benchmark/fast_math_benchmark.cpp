@@ -0,0 +1,107 @@
+#include "benchmarks.h"
+#include "../cli/options.h"
+#include "../cli/timer.h"
+#include "../math/fast_math.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// nanoseconds per value of the fastest of several runs
+double _fast_math_time (int runs, int count, const std::function<void ()>& f) {
+	double best = 1.0e30;
+	for (int i=0; i<runs; i++) {
+		Time_point start = now();
+		f();
+		best = std::min(best, seconds_since(start));
+	}
+	return best / count * 1.0e9;
+}
+
+// largest error of the scalar and array versions against the library function, printed with the bound
+bool _fast_math_error (const std::string& name, const std::vector<double>& exact, const std::vector<float>& scalar, const std::vector<float>& array, float bound) {
+	double error = 0;
+	for (unsigned i=0; i<exact.size(); i++)
+		error = std::max(error, std::max(std::fabs(scalar[i] - exact[i]), std::fabs(array[i] - exact[i])));
+	bool passed = error <= bound;
+	std::cout << "  " << name << " error " << error << ", bound " << bound << (passed ? "" : ", EXCEEDED") << "\n";
+	return passed;
+}
+
+bool fast_math_benchmark (const Options& o) {
+	int count = int_option(o, "count", 1000000);
+	int runs = int_option(o, "runs", 10);
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> angle(-fast_sincos_range, fast_sincos_range);
+	std::vector<float> x(count), y(count), a(count), u(count);
+	for (int i=0; i<count; i++) {
+		x[i] = unit(random);
+		y[i] = unit(random);
+		u[i] = unit(random);
+		// mostly angles of a few turns as in projections, some up to the end of the range
+		a[i] = i % 16 ? 4 * unit(random) : angle(random);
+	}
+	// edges of the domains and exact axes
+	const float edges[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 1.0e-7f, -1.0e-7f};
+	for (int i=0; i<8; i++) {
+		u[i] = edges[i];
+		x[i] = edges[i];
+		y[i] = edges[7-i];
+		a[i] = edges[i] * fast_pi;
+	}
+
+	std::vector<double> exact(count), exact_c(count);
+	std::vector<float> scalar(count), array(count), scalar_c(count), array_c(count);
+	bool passed = true;
+	std::cout << count << " values, nanoseconds per value for std:: in double, fast scalar and fast array\n";
+
+	double t_exact = _fast_math_time(runs, count, [&] () {
+		for (int i=0; i<count; i++) exact[i] = std::atan2((double)y[i], (double)x[i]);
+	});
+	double t_scalar = _fast_math_time(runs, count, [&] () {
+		for (int i=0; i<count; i++) scalar[i] = fast_atan2(y[i], x[i]);
+	});
+	double t_array = _fast_math_time(runs, count, [&] () {fast_atan2(y.data(), x.data(), array.data(), count);});
+	std::cout << "atan2: " << t_exact << ", " << t_scalar << ", " << t_array << "\n";
+	passed &= _fast_math_error("atan2", exact, scalar, array, fast_atan2_error);
+
+	t_exact = _fast_math_time(runs, count, [&] () {
+		for (int i=0; i<count; i++) exact[i] = std::asin((double)u[i]);
+	});
+	t_scalar = _fast_math_time(runs, count, [&] () {
+		for (int i=0; i<count; i++) scalar[i] = fast_asin(u[i]);
+	});
+	t_array = _fast_math_time(runs, count, [&] () {fast_asin(u.data(), array.data(), count);});
+	std::cout << "asin: " << t_exact << ", " << t_scalar << ", " << t_array << "\n";
+	passed &= _fast_math_error("asin", exact, scalar, array, fast_asin_error);
+
+	t_exact = _fast_math_time(runs, count, [&] () {
+		for (int i=0; i<count; i++) exact[i] = std::acos((double)u[i]);
+	});
+	t_scalar = _fast_math_time(runs, count, [&] () {
+		for (int i=0; i<count; i++) scalar[i] = fast_acos(u[i]);
+	});
+	t_array = _fast_math_time(runs, count, [&] () {fast_acos(u.data(), array.data(), count);});
+	std::cout << "acos: " << t_exact << ", " << t_scalar << ", " << t_array << "\n";
+	passed &= _fast_math_error("acos", exact, scalar, array, fast_acos_error);
+
+	t_exact = _fast_math_time(runs, count, [&] () {
+		for (int i=0; i<count; i++) {
+			exact[i] = std::sin((double)a[i]);
+			exact_c[i] = std::cos((double)a[i]);
+		}
+	});
+	t_scalar = _fast_math_time(runs, count, [&] () {
+		for (int i=0; i<count; i++) fast_sincos(a[i], scalar[i], scalar_c[i]);
+	});
+	t_array = _fast_math_time(runs, count, [&] () {fast_sincos(a.data(), array.data(), array_c.data(), count);});
+	std::cout << "sincos: " << t_exact << ", " << t_scalar << ", " << t_array << "\n";
+	passed &= _fast_math_error("sin", exact, scalar, array, fast_sincos_error);
+	passed &= _fast_math_error("cos", exact_c, scalar_c, array_c, fast_sincos_error);
+
+	std::cout << (passed ? "all errors within their bounds\n" : "some errors exceed their bounds\n");
+	return passed;
+}
@@ -0,0 +1,49 @@
+#include <iostream>
+#include <string>
+#include "../cli/options.h"
+#include "benchmarks.h"
+#include "../planet/grid/grid_cache.h"
+
+void print_usage () {
+	std::cout
+		<< "usage: earthgen-benchmark <benchmark> [--option value ...]\n"
+		<< "\n"
+		<< "options: --grid-cache <directory>\n"
+		<< "\n"
+		<< "benchmarks:\n"
+		<< "  point_location   --size --points\n"
+		<< "  season_codec     --size --seasons --keyframes\n"
+		<< "  concurrent_generation --size --seasons --planets --threads\n"
+		<< "  batch_math       --count --runs\n"
+		<< "  fast_math        --count --runs, fails if an error exceeds its bound\n"
+		<< "  stages           --sizes <n,m,...> --iterations <n,m,...> --seasons <n,m,...> --runs\n"
+		<< "                   --output <file>, appends json lines\n";
+}
+
+int main (int argc, char** argv) {
+	if (argc < 2) {
+		print_usage();
+		return 1;
+	}
+	std::string name = argv[1];
+	Options options(argc, argv, 2);
+	if (has_option(options, "grid-cache"))
+		set_grid_cache_directory(string_option(options, "grid-cache", ""));
+	if (name == "point_location")
+		point_location_benchmark(options);
+	else if (name == "season_codec")
+		season_codec_benchmark(options);
+	else if (name == "concurrent_generation")
+		concurrent_generation_benchmark(options);
+	else if (name == "batch_math")
+		batch_math_benchmark(options);
+	else if (name == "stages")
+		stage_benchmark(options);
+	else if (name == "fast_math")
+		return fast_math_benchmark(options) ? 0 : 1;
+	else {
+		print_usage();
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include "benchmarks.h"
+#include "../cli/options.h"
+#include "../cli/timer.h"
+#include "../planet/planet.h"
+#include "../planet/grid/tile_locator.h"
+#include <iostream>
+#include <random>
+#include <vector>
+
+const Tile* _linear_search (const Planet& p, const Vector3& v) {
+	for (const Tile& t : tiles(p))
+		if (contains(&t, v))
+			return &t;
+	return nullptr;
+}
+
+void point_location_benchmark (const Options& o) {
+	Planet planet;
+	set_grid_size(planet, int_option(o, "size", 8));
+	int count = int_option(o, "points", 1000000);
+
+	std::mt19937 random(1);
+	std::normal_distribution<float> gaussian;
+	std::vector<Vector3> points;
+	for (int i=0; i<count; i++)
+		points.push_back(normal(Vector3(gaussian(random), gaussian(random), gaussian(random))));
+
+	Time_point start = now();
+	Tile_locator locator;
+	init_locator(locator, planet);
+	double build_time = seconds_since(start);
+
+	start = now();
+	int checksum = 0;
+	for (const Vector3& v : points)
+		checksum += id(find_tile(locator, planet, v));
+	double locator_time = seconds_since(start);
+
+	// a path of small steps, as when following the mouse
+	std::vector<Vector3> path;
+	Vector3 v = points[0];
+	for (int i=0; i<count; i++) {
+		v = normal(v + Vector3(gaussian(random), gaussian(random), gaussian(random)) * 0.002);
+		path.push_back(v);
+	}
+	start = now();
+	const Tile* hint = nth_tile(planet, 0);
+	for (const Vector3& u : path) {
+		hint = find_tile(planet, u, hint);
+		checksum += id(hint);
+	}
+	double walk_time = seconds_since(start);
+
+	int linear_count = std::min(count, 200);
+	int mismatches = 0;
+	start = now();
+	for (int i=0; i<linear_count; i++)
+		if (_linear_search(planet, points[i]) != find_tile(locator, planet, points[i]))
+			mismatches++;
+	double linear_time = seconds_since(start);
+
+	std::cout
+		<< "tiles: " << tile_count(planet) << "\n"
+		<< "locator build: " << build_time << " s\n"
+		<< "locator: " << count / locator_time << " lookups/s\n"
+		<< "walk from previous tile: " << count / walk_time << " lookups/s\n"
+		<< "linear scan: " << linear_count / linear_time << " lookups/s\n"
+		<< "mismatches against linear scan: " << mismatches << " of " << linear_count << "\n"
+		<< "checksum: " << checksum << "\n";
+}
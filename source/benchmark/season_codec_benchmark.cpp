@@ -0,0 +1,82 @@
+#include "benchmarks.h"
+#include "../cli/options.h"
+#include "../cli/timer.h"
+#include "../planet/planet.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../io/season_codec.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// largest error of decoded against original, relative to the magnitude of the original
+double _relative_error (float original, float decoded) {
+	double magnitude = std::max(std::abs(original), 1.0e-30f);
+	return std::abs(original - decoded) / magnitude;
+}
+
+double _largest_error (const Season& a, const Season& b) {
+	double e = 0;
+	for (unsigned i=0; i<a.tiles.size(); i++) {
+		e = std::max(e, _relative_error(a.tiles[i].temperature, b.tiles[i].temperature));
+		e = std::max(e, _relative_error(a.tiles[i].humidity, b.tiles[i].humidity));
+		e = std::max(e, _relative_error(a.tiles[i].precipitation, b.tiles[i].precipitation));
+		e = std::max(e, _relative_error(a.tiles[i].wind.speed, b.tiles[i].wind.speed));
+	}
+	for (unsigned i=0; i<a.edges.size(); i++)
+		e = std::max(e, _relative_error(a.edges[i].wind_velocity, b.edges[i].wind_velocity));
+	return e;
+}
+
+void season_codec_benchmark (const Options& o) {
+	Terrain_parameters terrain = terrain_parameters(o);
+	terrain.grid_size = int_option(o, "size", 9);
+	Climate_parameters climate = climate_parameters(o);
+	climate.seasons = int_option(o, "seasons", 64);
+	int interval = int_option(o, "keyframes", default_keyframe_interval);
+
+	Planet planet;
+	generate_terrain(planet, terrain);
+	Compressed_climate compressed;
+	init_compressed_climate(compressed, planet, interval);
+	double encode_time = 0;
+	double largest_error = 0;
+	Season_decoder check;
+	// seasons are compressed as they are generated, so only one is held uncompressed
+	generate_climate(planet, climate, [&](int i, const Season& s) {
+		Time_point start = now();
+		append_season(compressed, s);
+		encode_time += seconds_since(start);
+		Season decoded;
+		decode_season(check, compressed, i, decoded);
+		largest_error = std::max(largest_error, _largest_error(s, decoded));
+	});
+
+	int seasons = compressed.seasons.size();
+	double raw = (double)raw_season_size(compressed) * seasons;
+	double size = compressed_size(compressed);
+
+	// stepping forward, as during playback, reuses the cached keyframe
+	Season_decoder decoder;
+	Season s;
+	Time_point start = now();
+	for (int i=0; i<seasons; i++)
+		decode_season(decoder, compressed, i, s);
+	double sequential = seconds_since(start) / seasons;
+
+	// jumping between keyframe groups decodes the keyframe as well
+	start = now();
+	for (int i=0; i<seasons; i++) {
+		Season_decoder cold;
+		decode_season(cold, compressed, (i*37 + 11) % seasons, s);
+	}
+	double random = seconds_since(start) / seasons;
+
+	std::cout
+		<< "grid size " << terrain.grid_size << ", " << seasons << " seasons, keyframe every " << interval << "\n"
+		<< "raw: " << raw / 1.0e6 << " MB, compressed: " << size / 1.0e6 << " MB, ratio " << raw / size << "\n"
+		<< "encode: " << encode_time / seasons * 1.0e3 << " ms per season\n"
+		<< "decode: " << sequential * 1.0e3 << " ms per season stepping, " << random * 1.0e3 << " ms per season jumping\n"
+		<< "decode throughput: " << raw / seasons / sequential / 1.0e6 << " MB/s\n"
+		<< "largest relative error: " << largest_error << "\n";
+}
@@ -0,0 +1,213 @@
+#include "benchmarks.h"
+#include "../cli/options.h"
+#include "../cli/timer.h"
+#include "../planet/planet.h"
+#include "../planet/generation_context.h"
+#include "../planet/grid/create_grid.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../render/planet_colours.h"
+#include "../render/hammer_projection.h"
+#include "../thread/parallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+// one measurement, fields that don't apply to the stage are left at -1 or empty and not written
+class Stage_record {
+public:
+	Stage_record () :
+		grid_size (-1), tiles (-1), iterations (-1), seasons (-1), season (-1), sweeps (-1), cached (-1), seconds (0) {}
+
+	std::string stage;
+	std::string mode;
+	int grid_size;
+	int tiles;
+	int iterations;
+	int seasons;
+	int season;
+	int sweeps;
+	int cached;
+	double seconds;
+};
+
+class Stage_output {
+public:
+	Stage_output () :
+		out (nullptr), started (0), threads (0) {}
+
+	std::ostream* out;
+	long long started;
+	int threads;
+};
+
+void _write_record (Stage_output& o, const Stage_record& r) {
+	std::ostringstream line;
+	line.precision(9);
+	line << "{\"benchmark\":\"stages\",\"started\":" << o.started << ",\"threads\":" << o.threads
+		<< ",\"stage\":\"" << r.stage << "\"";
+	if (!r.mode.empty()) line << ",\"mode\":\"" << r.mode << "\"";
+	if (r.grid_size >= 0) line << ",\"grid_size\":" << r.grid_size;
+	if (r.tiles >= 0) line << ",\"tiles\":" << r.tiles;
+	if (r.iterations >= 0) line << ",\"iterations\":" << r.iterations;
+	if (r.seasons >= 0) line << ",\"seasons\":" << r.seasons;
+	if (r.season >= 0) line << ",\"season\":" << r.season;
+	if (r.sweeps >= 0) line << ",\"sweeps\":" << r.sweeps;
+	if (r.cached >= 0) line << ",\"cached\":" << (r.cached ? "true" : "false");
+	line << ",\"seconds\":" << r.seconds << "}\n";
+	*o.out << line.str() << std::flush;
+}
+
+// fastest of several runs, setup is not timed
+double _best_time (int runs, const std::function<void ()>& setup, const std::function<void ()>& f) {
+	double best = 1.0e30;
+	for (int i=0; i<runs; i++) {
+		setup();
+		Time_point start = now();
+		f();
+		best = std::min(best, seconds_since(start));
+	}
+	return best;
+}
+
+std::vector<int> _int_list (const Options& o, const std::string& name, const std::vector<int>& default_values) {
+	std::vector<int> values;
+	for (const std::string& value : list_option(o, name))
+		values.push_back(std::atoi(value.c_str()));
+	return values.empty() ? default_values : values;
+}
+
+void _grid_stage (Stage_output& out, int size, int runs) {
+	Stage_record r;
+	r.stage = "size_n_grid";
+	r.grid_size = size;
+	r.seconds = _best_time(runs, [] () {}, [&] () {
+		Grid* grid = size_n_grid(size);
+		r.tiles = grid->tiles.size();
+		delete grid;
+	});
+	_write_record(out, r);
+}
+
+void _terrain_stages (Stage_output& out, Planet& planet, const Terrain_parameters& par) {
+	Generation_context c;
+	generate_terrain(planet, par, c);
+	for (const Generation_stage& s : c.stages) {
+		Stage_record r;
+		r.stage = "terrain_" + s.name;
+		r.grid_size = par.grid_size;
+		r.tiles = tile_count(planet);
+		r.iterations = par.iterations;
+		r.seconds = s.seconds;
+		_write_record(out, r);
+	}
+}
+
+void _climate_stages (Stage_output& out, Planet& planet, const Terrain_parameters& terrain, const Climate_parameters& par) {
+	init_climate(planet, par);
+	for (int i=0; i<par.seasons; i++) {
+		Generation_context c;
+		Season s;
+		int sweeps = generate_season(planet, par, (float)i/par.seasons, s, c);
+		m_climate(planet).seasons.push_back(s);
+		for (const Generation_stage& stage : c.stages) {
+			Stage_record r;
+			r.stage = "season_" + stage.name;
+			r.grid_size = terrain.grid_size;
+			r.tiles = tile_count(planet);
+			r.iterations = terrain.iterations;
+			r.seasons = par.seasons;
+			r.season = i;
+			if (stage.name == "humidity")
+				r.sweeps = sweeps;
+			r.seconds = stage.seconds;
+			_write_record(out, r);
+		}
+	}
+	m_climate(planet).var.season_count = par.seasons;
+}
+
+void _colour_stages (Stage_output& out, const Planet& planet, int runs) {
+	static const char* names[6] = {"topography", "vegetation", "temperature", "aridity", "humidity", "precipitation"};
+	Planet_colours colours;
+	init_colours(colours, planet);
+	const Season* season = &nth_season(planet, 0);
+	for (int cached=0; cached<2; cached++) {
+		for (int i=0; i<6; i++) {
+			Stage_record r;
+			r.stage = "set_colours";
+			r.mode = names[i];
+			r.grid_size = planet.grid->size;
+			r.tiles = tile_count(planet);
+			// uncached runs start from empty colours, without elevations or palette coordinates
+			r.cached = cached;
+			r.seconds = _best_time(runs, [&] () {
+				if (!cached)
+					init_colours(colours, planet);
+			}, [&] () {
+				set_colours(colours, planet, season, colour_mode(names[i]));
+			});
+			_write_record(out, r);
+		}
+	}
+}
+
+void _geometry_stage (Stage_output& out, const Planet& planet, int runs) {
+	Hammer_projection projection;
+	Stage_record r;
+	r.stage = "create_geometry";
+	r.grid_size = planet.grid->size;
+	r.tiles = tile_count(planet);
+	r.seconds = _best_time(runs, [&] () {clear(projection);}, [&] () {
+		create_geometry(projection, planet, rotation_to_default(planet));
+	});
+	_write_record(out, r);
+}
+
+void stage_benchmark (const Options& o) {
+	std::vector<int> sizes = _int_list(o, "sizes", {0, 1, 2, 3, 4, 5, 6, 7});
+	std::vector<int> iterations = _int_list(o, "iterations", {1000});
+	std::vector<int> season_counts = _int_list(o, "seasons", {1, 4});
+	int runs = std::max(1, int_option(o, "runs", 3));
+	Terrain_parameters terrain = terrain_parameters(o);
+	Climate_parameters climate = climate_parameters(o);
+
+	Stage_output out;
+	std::ofstream file;
+	out.out = &std::cout;
+	if (has_option(o, "output")) {
+		file.open(string_option(o, "output", "").c_str(), std::ios::app);
+		if (!file) {
+			std::cerr << "could not write " << string_option(o, "output", "") << "\n";
+			return;
+		}
+		out.out = &file;
+	}
+	out.started = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	out.threads = thread_count();
+
+	for (int size : sizes) {
+		_grid_stage(out, size, runs);
+		for (int n : iterations) {
+			terrain.grid_size = size;
+			terrain.iterations = n;
+			terrain.correct_values();
+			Planet planet;
+			_terrain_stages(out, planet, terrain);
+			for (int seasons : season_counts) {
+				climate.seasons = seasons;
+				climate.correct_values();
+				_climate_stages(out, planet, terrain, climate);
+			}
+			// colours and geometry don't depend on the iterations
+			if (n == iterations[0]) {
+				_colour_stages(out, planet, runs);
+				_geometry_stage(out, planet, runs);
+			}
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#include "commands.h"
+#include "options.h"
+#include "../planet/planet.h"
+#include "../planet/planet_cache.h"
+#include "../planet/planet_memory.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../render/planet_colours.h"
+#include "../render/software_renderer.h"
+#include "../render/image.h"
+#include "../io/png.h"
+#include "../thread/thread_pool.h"
+#include "timer.h"
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+
+int animate_command (const Options& o) {
+	std::string view = string_option(o, "view", "map");
+	int mode = colour_mode(string_option(o, "colour", "vegetation"));
+	if (mode < 0 || (view != "map" && view != "globe")) {
+		std::cerr << "unknown colour mode or view\n";
+		return 1;
+	}
+	int width = int_option(o, "width", 1024);
+	int height = int_option(o, "height", view == "map" ? width/2 : width);
+	if (width < 1 || height < 1) {
+		std::cerr << "width and height have to be at least 1\n";
+		return 1;
+	}
+	std::string output = string_option(o, "output", "season");
+
+	Terrain_parameters terrain = terrain_parameters(o);
+	Climate_parameters climate = climate_parameters(o);
+	if (!check_memory_budget(terrain, climate.seasons, Memory_estimate::seasons_raw))
+		return 1;
+	Planet planet;
+	cached_planet(planet, terrain, climate);
+
+	Time_point start = now();
+	// the view is the same in every frame, only colours change
+	Raster_geometry geometry;
+	view_geometry(geometry, planet, o, view, width, height);
+	double geometry_time = seconds_since(start);
+
+	start = now();
+	Thread_pool pool;
+	std::atomic<int> failed(0);
+	for (int i=0; i<season_count(planet); i++) {
+		submit(pool, [&, i] () {
+			Planet_colours colours;
+			init_colours(colours, planet);
+			set_colours(colours, planet, &nth_season(planet, i), mode);
+			Image image(width, height);
+			draw_tiles(image, geometry, colours);
+			char number[16];
+			std::snprintf(number, sizeof(number), "_%03d.png", i);
+			if (!write_png(output + number, image)) {
+				std::cerr << "could not write " << output + number << "\n";
+				failed++;
+			}
+		});
+	}
+	wait(pool);
+	double frame_time = seconds_since(start);
+
+	std::cout
+		<< "threads: " << worker_count(pool) << "\n"
+		<< "geometry: " << geometry_time << " s\n"
+		<< "frames: " << season_count(planet) << " in " << frame_time << " s, "
+		<< season_count(planet) / frame_time << " frames/s\n";
+	return failed > 0 ? 1 : 0;
+}
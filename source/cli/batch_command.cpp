@@ -0,0 +1,267 @@
+#include "commands.h"
+#include "options.h"
+#include "../planet/planet.h"
+#include "../planet/planet_memory.h"
+#include "../planet/generation_context.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../io/planet_file.h"
+#include "../thread/task_scheduler.h"
+#include "../thread/parallel.h"
+#include "timer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+// area weighted sums over the tiles of one season
+class Batch_season {
+public:
+	Batch_season () :
+		temperature (0), lowest_temperature (0), highest_temperature (0), precipitation (0), land_precipitation (0), seconds (0) {}
+
+	double temperature;
+	float lowest_temperature;
+	float highest_temperature;
+	double precipitation;
+	double land_precipitation;
+	// time spent generating the season
+	double seconds;
+};
+
+// one planet of a sweep, shared by its terrain task and season tasks
+class Batch_planet {
+public:
+	Batch_planet () :
+		land_area (0), remaining (0), terrain_seconds (0) {}
+
+	Terrain_parameters terrain;
+	Climate_parameters climate;
+	Planet planet;
+	std::vector<double> area;
+	double land_area;
+	std::vector<Batch_season> summaries;
+	// kept only when planets are saved
+	std::vector<Season> seasons;
+	// season tasks not yet finished, the last one writes the results
+	std::atomic<int> remaining;
+	double terrain_seconds;
+};
+
+class Batch_output {
+public:
+	Batch_output () :
+		completed (0) {}
+
+	std::mutex mutex;
+	std::ofstream metrics;
+	std::string planet_directory;
+	int completed;
+	int total;
+};
+
+std::vector<std::string> _batch_seeds (const Options& o) {
+	std::vector<std::string> seeds = list_option(o, "seeds");
+	if (has_option(o, "seed-file")) {
+		std::ifstream in(string_option(o, "seed-file", "").c_str());
+		std::string line;
+		while (std::getline(in, line))
+			if (!line.empty())
+				seeds.push_back(line);
+	}
+	if (has_option(o, "count")) {
+		std::string prefix = string_option(o, "seed-prefix", "seed");
+		int first = int_option(o, "first", 0);
+		for (int i=0; i<int_option(o, "count", 0); i++) {
+			std::ostringstream seed;
+			seed << prefix << first + i;
+			seeds.push_back(seed.str());
+		}
+	}
+	if (seeds.empty())
+		seeds.push_back(string_option(o, "seed", "earthgen"));
+	return seeds;
+}
+
+void _summarize_season (Batch_planet& b, const Season& s, Batch_season& summary) {
+	summary.lowest_temperature = s.tiles.empty() ? 0 : s.tiles[0].temperature;
+	summary.highest_temperature = summary.lowest_temperature;
+	for (unsigned i=0; i<s.tiles.size(); i++) {
+		const Climate_tile& t = s.tiles[i];
+		summary.temperature += b.area[i] * t.temperature;
+		summary.lowest_temperature = std::min(summary.lowest_temperature, t.temperature);
+		summary.highest_temperature = std::max(summary.highest_temperature, t.temperature);
+		summary.precipitation += b.area[i] * t.precipitation;
+		if (is_land(nth_tile(terrain(b.planet), i)))
+			summary.land_precipitation += b.area[i] * t.precipitation;
+	}
+}
+
+void _write_batch_planet (Batch_planet& b, Batch_output& out) {
+	double total_area = 0;
+	for (double a : b.area)
+		total_area += a;
+	Batch_season year;
+	if (!b.summaries.empty()) {
+		year.lowest_temperature = b.summaries[0].lowest_temperature;
+		year.highest_temperature = b.summaries[0].highest_temperature;
+	}
+	for (const Batch_season& s : b.summaries) {
+		year.temperature += s.temperature / b.summaries.size();
+		year.lowest_temperature = std::min(year.lowest_temperature, s.lowest_temperature);
+		year.highest_temperature = std::max(year.highest_temperature, s.highest_temperature);
+		year.precipitation += s.precipitation / b.summaries.size();
+		year.land_precipitation += s.land_precipitation / b.summaries.size();
+		year.seconds += s.seconds;
+	}
+
+	bool saved = true;
+	if (!out.planet_directory.empty()) {
+		for (Season& s : b.seasons)
+			m_climate(b.planet).seasons.push_back(std::move(s));
+		m_climate(b.planet).var.season_count = b.climate.seasons;
+		std::ostringstream name;
+		name << out.planet_directory << "/" << b.terrain.seed << "_" << b.terrain.grid_size << ".planet";
+		saved = save_planet(name.str(), b.planet);
+	}
+
+	std::ostringstream row;
+	row << b.terrain.seed << ","
+		<< b.terrain.grid_size << ","
+		<< b.climate.seasons << ","
+		<< b.land_area / total_area << ","
+		<< year.temperature / total_area << ","
+		<< year.lowest_temperature << ","
+		<< year.highest_temperature << ","
+		<< year.precipitation / total_area << ","
+		<< (b.land_area > 0 ? year.land_precipitation / b.land_area : 0) << ","
+		<< b.terrain_seconds << ","
+		<< year.seconds << "\n";
+	std::lock_guard<std::mutex> lock(out.mutex);
+	// each planet is on disk as soon as it is done, a sweep stopped early keeps its results
+	out.metrics << row.str() << std::flush;
+	out.completed++;
+	if (!saved)
+		std::cerr << "could not save " << b.terrain.seed << "\n";
+}
+
+void _generate_batch_season (std::shared_ptr<Batch_planet> b, Batch_output& out, int n) {
+	Time_point start = now();
+	Season s;
+	generate_season(b->planet, b->climate, (float)n / b->climate.seasons, s);
+	b->summaries[n].seconds = seconds_since(start);
+	_summarize_season(*b, s, b->summaries[n]);
+	if (!out.planet_directory.empty())
+		b->seasons[n] = std::move(s);
+	if (--b->remaining == 0)
+		_write_batch_planet(*b, out);
+}
+
+void _generate_batch_terrain (Task_scheduler& scheduler, std::shared_ptr<Batch_planet> b, Batch_output& out) {
+	Time_point start = now();
+	Generation_context c;
+	// tasks already keep every core busy
+	c.threads = 1;
+	generate_terrain(b->planet, b->terrain, c);
+	init_climate(b->planet, b->climate);
+	b->terrain_seconds = seconds_since(start);
+
+	b->area.resize(tile_count(b->planet));
+	b->land_area = 0;
+	for (int i=0; i<tile_count(b->planet); i++) {
+		b->area[i] = area(b->planet, nth_tile(b->planet, i));
+		if (is_land(nth_tile(terrain(b->planet), i)))
+			b->land_area += b->area[i];
+	}
+	b->summaries.resize(b->climate.seasons);
+	if (!out.planet_directory.empty())
+		b->seasons.resize(b->climate.seasons);
+	b->remaining = b->climate.seasons;
+	// seasons are independent once the terrain exists, so each is its own task and idle
+	// workers steal them from planets with many seasons
+	for (int n=0; n<b->climate.seasons; n++)
+		submit(scheduler, [b, &out, n] () {_generate_batch_season(b, out, n);});
+}
+
+// every worker may be generating a planet of its own, each holding its grid, terrain and
+// the season it works on, or all of its seasons when planets are saved
+Memory_estimate _batch_planet_memory (const Terrain_parameters& terrain, const Climate_parameters& climate, bool saved) {
+	return estimate_memory(terrain.grid_size, terrain.iterations, saved ? climate.seasons : 1, Memory_estimate::seasons_raw);
+}
+
+// the number of workers whose planets fit in the memory budget together, 0 if not even one does
+int _batch_threads (const Terrain_parameters& terrain, const Climate_parameters& climate, const std::vector<int>& sizes, bool saved, int threads) {
+	if (memory_budget() <= 0)
+		return threads;
+	for (int size : sizes) {
+		Terrain_parameters t = terrain;
+		t.grid_size = size;
+		t.correct_values();
+		Memory_estimate m = _batch_planet_memory(t, climate, saved);
+		if (!check_memory_budget(t, saved ? climate.seasons : 1, Memory_estimate::seasons_raw))
+			return 0;
+		threads = std::min(threads, (int)(memory_budget() / peak_bytes(m)));
+	}
+	return threads;
+}
+
+int batch_command (const Options& o) {
+	std::vector<std::string> seeds = _batch_seeds(o);
+	Terrain_parameters terrain = terrain_parameters(o);
+	Climate_parameters climate = climate_parameters(o);
+	std::vector<int> sizes;
+	for (const std::string& size : list_option(o, "sizes"))
+		sizes.push_back(std::atoi(size.c_str()));
+	if (sizes.empty())
+		sizes.push_back(terrain.grid_size);
+	bool saved = !string_option(o, "planets", "").empty();
+
+	int threads = int_option(o, "threads", 0);
+	if (threads <= 0)
+		threads = thread_count();
+	int fitting = _batch_threads(terrain, climate, sizes, saved, threads);
+	if (fitting == 0)
+		return 1;
+	if (fitting < threads) {
+		std::cerr << "using " << fitting << " threads instead of " << threads << " to stay within the memory budget\n";
+		threads = fitting;
+	}
+
+	Batch_output out;
+	std::string output = string_option(o, "output", "batch.csv");
+	out.metrics.open(output.c_str());
+	if (!out.metrics) {
+		std::cerr << "could not write " << output << "\n";
+		return 1;
+	}
+	out.metrics
+		<< "seed,grid_size,seasons,land_fraction,mean_temperature,lowest_temperature,highest_temperature,"
+		<< "mean_precipitation,mean_land_precipitation,terrain_seconds,climate_seconds\n";
+	out.planet_directory = string_option(o, "planets", "");
+	out.total = seeds.size() * sizes.size();
+
+	Time_point start = now();
+	Task_scheduler scheduler(threads);
+	for (int size : sizes) {
+		for (const std::string& seed : seeds) {
+			std::shared_ptr<Batch_planet> b(new Batch_planet());
+			b->terrain = terrain;
+			b->terrain.seed = seed;
+			b->terrain.grid_size = size;
+			b->terrain.correct_values();
+			b->climate = climate;
+			submit(scheduler, [&scheduler, b, &out] () {_generate_batch_terrain(scheduler, b, out);});
+		}
+	}
+	wait(scheduler);
+	double seconds = seconds_since(start);
+
+	std::cout
+		<< out.completed << " planets on " << worker_count(scheduler) << " threads in " << seconds << " s, "
+		<< out.completed / seconds * 3600 << " planets per hour, " << scheduler.steals << " tasks stolen\n";
+	return out.completed == out.total ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+#ifndef commands_h
+#define commands_h
+
+#include <string>
+class Options;
+class Planet;
+class Raster_geometry;
+class Terrain_parameters;
+
+// renders one view of a generated planet to a png
+int render_command (const Options&);
+// renders every season of a generated climate to a numbered png sequence
+int animate_command (const Options&);
+// streams terrain and every season, as it is generated, to a chunked column file
+int export_command (const Options&);
+// samples elevation or a climate quantity, interpolated within tiles, onto an equirectangular or cube map raster
+int raster_command (const Options&);
+// generates every combination of seeds and grid sizes on a work stealing scheduler,
+// appending a row of summary metrics to a csv file as each planet completes
+int batch_command (const Options&);
+// checks generated planets against stored digests of every terrain and climate array,
+// reporting the arrays, stages and values that diverge
+int golden_command (const Options&);
+// predicted memory of grid, terrain, seasons, generation and rendering for each grid size,
+// and with --measure the peak resident size of generating each
+int memory_command (const Options&);
+
+// map or globe geometry as selected by the view options
+void view_geometry (Raster_geometry&, const Planet&, const Options&, const std::string& view, int width, int height);
+
+// Memory_estimate season storage by name, -1 if unknown
+int season_storage (const std::string&);
+// false, with a message, if the planet would exceed the memory budget
+bool check_memory_budget (const Terrain_parameters&, int seasons, int storage);
+
+#endif
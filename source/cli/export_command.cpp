@@ -0,0 +1,42 @@
+#include "commands.h"
+#include "options.h"
+#include "../planet/planet.h"
+#include "../planet/planet_cache.h"
+#include "../planet/planet_memory.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../io/column_export.h"
+#include "timer.h"
+#include <iostream>
+
+int export_command (const Options& o) {
+	std::string output = string_option(o, "output", "planet.columns");
+	Climate_parameters climate = climate_parameters(o);
+
+	Terrain_parameters terrain = terrain_parameters(o);
+	if (!check_memory_budget(terrain, climate.seasons, Memory_estimate::seasons_streamed))
+		return 1;
+
+	Time_point start = now();
+	Planet planet;
+	// the climate is streamed rather than held, so only the terrain goes through the cache
+	cached_terrain(planet, terrain);
+	Column_writer writer;
+	if (!open_column_writer(writer, output, planet, climate.seasons, int_option(o, "chunk", 65536))) {
+		std::cerr << "could not write " << output << "\n";
+		return 1;
+	}
+	write_terrain_columns(writer, planet);
+	// each season is written as soon as it is generated and then discarded
+	generate_climate(planet, climate, [&](int i, const Season& s) {
+		write_season_columns(writer, planet, s, i);
+	});
+	if (!close_column_writer(writer)) {
+		std::cerr << "could not write " << output << "\n";
+		return 1;
+	}
+	std::cout
+		<< "chunks: " << writer.chunks.size() << ", " << writer.offset / 1.0e6 << " MB\n"
+		<< "time: " << seconds_since(start) << " s\n";
+	return 0;
+}
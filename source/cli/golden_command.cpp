@@ -0,0 +1,227 @@
+#include "commands.h"
+#include "options.h"
+#include "../planet/planet.h"
+#include "../planet/planet_digest.h"
+#include "../planet/planet_cache.h"
+#include "../planet/generation_context.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../io/planet_file.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+// digest files are text: a header line, then for each planet a line "planet <parameters>",
+// the parameter_text of its terrain and climate, followed by one line per array
+// "<name> <stage> <count> <hash> <block hash>,<block hash>,...", hashes in hexadecimal
+const char* const golden_header = "earthgen golden 3";
+// reference digests of the default seed and sizes, checked in with the source
+const char* const golden_file = "golden/digests.txt";
+
+std::string _golden_name (const Terrain_parameters& terrain) {
+	std::ostringstream name;
+	name << terrain.seed << ", size " << terrain.grid_size;
+	return name.str();
+}
+
+bool _write_golden (const std::string& name, const std::map<std::string, std::vector<Array_digest> >& planets) {
+	std::ofstream out(name.c_str());
+	out << golden_header << "\n" << std::hex;
+	for (auto& planet : planets) {
+		out << "planet " << planet.first << "\n";
+		for (const Array_digest& d : planet.second) {
+			out << d.name << " " << d.stage << " " << std::dec << d.count << std::hex << " " << d.hash << " ";
+			for (unsigned i=0; i<d.blocks.size(); i++)
+				out << (i ? "," : "") << d.blocks[i];
+			out << "\n";
+		}
+	}
+	out.close();
+	return !out.fail();
+}
+
+// reference digests by planet key
+bool _read_golden (const std::string& name, std::map<std::string, std::vector<Array_digest> >& planets) {
+	std::ifstream in(name.c_str());
+	std::string line;
+	if (!std::getline(in, line) || line != golden_header)
+		return false;
+	std::vector<Array_digest>* current = nullptr;
+	while (std::getline(in, line)) {
+		if (line.compare(0, 7, "planet ") == 0) {
+			current = &planets[line.substr(7)];
+			continue;
+		}
+		if (!current)
+			return false;
+		std::istringstream fields(line);
+		Array_digest d;
+		std::string blocks;
+		fields >> d.name >> d.stage >> d.count >> std::hex >> d.hash >> blocks;
+		if (fields.fail())
+			return false;
+		std::istringstream block_list(blocks);
+		std::string block;
+		while (std::getline(block_list, block, ','))
+			d.blocks.push_back(std::strtoull(block.c_str(), nullptr, 16));
+		current->push_back(d);
+	}
+	return true;
+}
+
+std::string _reference_file (const std::string& directory, const Terrain_parameters& terrain, const Climate_parameters& climate) {
+	return directory + "/" + climate_key(terrain, climate) + ".planet";
+}
+
+void _generate_golden (Planet& planet, const Terrain_parameters& terrain, const Climate_parameters& climate) {
+	Generation_context c;
+	generate_terrain(planet, terrain, c);
+	generate_climate(planet, climate, c);
+}
+
+// values of the first and last block as an index range
+std::string _block_range (const std::vector<int>& blocks, int count) {
+	std::ostringstream range;
+	int last = std::min(count, (blocks.back() + 1) * digest_block_size) - 1;
+	range << blocks.size() << " of " << (count + digest_block_size - 1) / digest_block_size
+		<< " blocks, values " << blocks.front() * digest_block_size << " to " << last;
+	return range.str();
+}
+
+// writes the arrays that differ, in generation order, and returns whether all matched
+bool _check_golden (std::ostream& out, const Planet& planet, const std::vector<Array_digest>& reference, const Planet* reference_planet, double tolerance) {
+	std::vector<Planet_array> arrays = planet_arrays(planet);
+	std::vector<Planet_array> reference_arrays;
+	if (reference_planet)
+		reference_arrays = planet_arrays(*reference_planet);
+	std::map<std::string, const Planet_array*> by_name;
+	for (const Planet_array& a : reference_arrays)
+		by_name[a.name] = &a;
+
+	bool matched = arrays.size() == reference.size();
+	if (!matched)
+		out << "  " << arrays.size() << " arrays, reference has " << reference.size() << "\n";
+	std::string first_stage;
+	for (unsigned i=0; i<arrays.size() && i<reference.size(); i++) {
+		Array_digest d = array_digest(arrays[i]);
+		const Array_digest& r = reference[i];
+		if (d.name == r.name && d.count == r.count && d.hash == r.hash)
+			continue;
+		if (d.name != r.name || d.count != r.count) {
+			out << "  " << d.name << " (" << d.count << " values) where the reference has " << r.name << " (" << r.count << " values)\n";
+			return false;
+		}
+		// bit differences within the tolerance don't count, which needs the reference values
+		auto found = by_name.find(d.name);
+		if (found != by_name.end()) {
+			Array_difference difference = compare_arrays(*found->second, arrays[i], tolerance);
+			if (difference.differing == 0)
+				continue;
+			out << "  " << d.name << " (" << d.stage << "): " << difference.differing << " of " << d.count << " values differ";
+			if (arrays[i].floating)
+				out << " by up to " << difference.largest;
+			out << ", first at";
+			for (int index : difference.first)
+				out << " " << index;
+			out << "\n";
+		}
+		else
+			out << "  " << d.name << " (" << d.stage << "): " << _block_range(differing_blocks(r, d), d.count) << "\n";
+		if (matched)
+			first_stage = d.stage;
+		matched = false;
+	}
+	if (!first_stage.empty())
+		out << "  first diverging stage: " << first_stage << "\n";
+	return matched;
+}
+
+int golden_command (const Options& o) {
+	std::vector<std::string> seeds = list_option(o, "seeds");
+	if (seeds.empty())
+		seeds.push_back(string_option(o, "seed", "earthgen"));
+	std::vector<int> sizes;
+	for (const std::string& size : list_option(o, "sizes"))
+		sizes.push_back(std::atoi(size.c_str()));
+	if (sizes.empty())
+		sizes = {3, 5};
+	Terrain_parameters terrain = terrain_parameters(o);
+	Climate_parameters climate = climate_parameters(o);
+	climate.seasons = int_option(o, "seasons", 2);
+	climate.correct_values();
+	std::string digest_file = string_option(o, "digests", golden_file);
+	std::string reference_directory = string_option(o, "reference", "");
+	double tolerance = real_option(o, "tolerance", 0);
+	bool update = has_option(o, "update");
+	if (tolerance > 0 && reference_directory.empty() && !update) {
+		std::cerr << "--tolerance compares values, which needs the planets saved with --reference\n";
+		return 1;
+	}
+
+	// updating replaces the digests of the planets generated and keeps the others
+	std::map<std::string, std::vector<Array_digest> > reference;
+	if (!_read_golden(digest_file, reference)) {
+		if (!update) {
+			std::cerr << "could not read " << digest_file << ", create it with --update\n";
+			return 1;
+		}
+		reference.clear();
+		std::cout << "starting a new " << digest_file << "\n";
+	}
+
+	int failed = 0;
+	for (int size : sizes) {
+		for (const std::string& seed : seeds) {
+			Terrain_parameters planet_terrain = terrain;
+			planet_terrain.seed = seed;
+			planet_terrain.grid_size = size;
+			planet_terrain.correct_values();
+			Planet planet;
+			_generate_golden(planet, planet_terrain, climate);
+			std::string key = parameter_text(planet_terrain, climate);
+			std::string name = _golden_name(planet_terrain);
+
+			if (update) {
+				std::vector<Array_digest>& digests = reference[key];
+				digests.clear();
+				for (const Planet_array& a : planet_arrays(planet))
+					digests.push_back(array_digest(a));
+				if (!reference_directory.empty() && !save_planet(_reference_file(reference_directory, planet_terrain, climate), planet)) {
+					std::cerr << "could not save the reference planet for " << name << "\n";
+					return 1;
+				}
+				std::cout << name << ": recorded\n";
+				continue;
+			}
+
+			auto found = reference.find(key);
+			if (found == reference.end()) {
+				std::cout << name << ": no digests\n";
+				failed++;
+				continue;
+			}
+			Planet reference_planet;
+			bool has_reference = !reference_directory.empty() &&
+				load_planet(reference_planet, _reference_file(reference_directory, planet_terrain, climate));
+			if (!reference_directory.empty() && !has_reference)
+				std::cout << name << ": no reference planet, comparing digests only\n";
+			std::ostringstream report;
+			bool matched = _check_golden(report, planet, found->second, has_reference ? &reference_planet : nullptr, tolerance);
+			std::cout << name << ": " << (matched ? "matches" : "differs") << "\n" << report.str();
+			if (!matched)
+				failed++;
+		}
+	}
+
+	if (update) {
+		if (!_write_golden(digest_file, reference)) {
+			std::cerr << "could not write " << digest_file << "\n";
+			return 1;
+		}
+		return 0;
+	}
+	std::cout << failed << " of " << seeds.size() * sizes.size() << " planets differ\n";
+	return failed ? 1 : 0;
+}
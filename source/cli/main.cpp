@@ -0,0 +1,62 @@
+#include <iostream>
+#include <string>
+#include "options.h"
+#include "commands.h"
+#include "../planet/grid/grid_cache.h"
+#include "../planet/planet_cache.h"
+#include "../planet/planet_memory.h"
+
+void print_usage () {
+	std::cout
+		<< "usage: earthgen-cli <command> [--option value ...]\n"
+		<< "\n"
+		<< "planet options: --seed --size --iterations --water --seasons --tilt\n"
+		<< "                --grid-cache <directory> --cache <directory> --memory-budget <MB>\n"
+		<< "\n"
+		<< "commands:\n"
+		<< "  render   --view map|globe --colour <mode> --season --width --height\n"
+		<< "           --latitude --longitude --output <file.png>\n"
+		<< "  animate  --view map|globe --colour <mode> --width --height\n"
+		<< "           --latitude --longitude --output <prefix>, writes <prefix>_<season>.png\n"
+		<< "  export   --chunk <values per chunk> --output <file>\n"
+		<< "  raster   --field elevation|temperature|humidity|precipitation --season\n"
+		<< "           --projection equirectangular|cube --width --output <file.pfm>\n"
+		<< "  batch    --seeds <a,b,...> --seed-file <file> --seed-prefix --first --count\n"
+		<< "           --sizes <n,m,...> --threads --output <file.csv> --planets <directory>\n"
+		<< "  golden   --seeds <a,b,...> --sizes <n,m,...> --digests <file> --update\n"
+		<< "           --reference <directory> --tolerance <relative>\n"
+		<< "  memory   --sizes <n,m,...> --storage raw|compressed|streamed --measure\n"
+		<< "\n"
+		<< "colour modes: topography vegetation temperature aridity humidity precipitation\n";
+}
+
+int main (int argc, char** argv) {
+	if (argc < 2) {
+		print_usage();
+		return 1;
+	}
+	std::string command = argv[1];
+	Options options(argc, argv, 2);
+	if (has_option(options, "grid-cache"))
+		set_grid_cache_directory(string_option(options, "grid-cache", ""));
+	if (has_option(options, "cache"))
+		set_planet_cache_directory(string_option(options, "cache", ""));
+	if (has_option(options, "memory-budget"))
+		set_memory_budget(real_option(options, "memory-budget", 0) * 1024 * 1024);
+	if (command == "render")
+		return render_command(options);
+	if (command == "animate")
+		return animate_command(options);
+	if (command == "export")
+		return export_command(options);
+	if (command == "raster")
+		return raster_command(options);
+	if (command == "batch")
+		return batch_command(options);
+	if (command == "golden")
+		return golden_command(options);
+	if (command == "memory")
+		return memory_command(options);
+	print_usage();
+	return 1;
+}
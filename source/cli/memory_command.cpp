@@ -0,0 +1,136 @@
+#include "commands.h"
+#include "options.h"
+#include "../planet/planet.h"
+#include "../planet/planet_memory.h"
+#include "../planet/generation_context.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../render/planet_colours.h"
+#include "../render/hammer_projection.h"
+#include "../io/season_codec.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+double _megabytes (double bytes) {
+	return bytes / (1024 * 1024);
+}
+
+int season_storage (const std::string& name) {
+	if (name == "raw") return Memory_estimate::seasons_raw;
+	if (name == "compressed") return Memory_estimate::seasons_compressed;
+	if (name == "streamed") return Memory_estimate::seasons_streamed;
+	return -1;
+}
+
+bool check_memory_budget (const Terrain_parameters& terrain, int seasons, int storage) {
+	Memory_estimate m = estimate_memory(terrain.grid_size, terrain.iterations, seasons, storage);
+	if (within_memory_budget(m))
+		return true;
+	std::cerr << std::fixed << std::setprecision(1)
+		<< "grid size " << terrain.grid_size << " needs about " << _megabytes(peak_bytes(m))
+		<< " MB, over the memory budget of " << _megabytes(memory_budget()) << " MB\n";
+	return false;
+}
+
+// generates the planet the estimate is for, colours as many seasons as colours keep
+// and projects it, keeping seasons as the storage says
+void _generate_measured (const Terrain_parameters& terrain, const Climate_parameters& climate, int storage) {
+	Planet planet;
+	Generation_context c;
+	generate_terrain(planet, terrain, c);
+	Compressed_climate compressed;
+	Season_decoder decoder;
+	if (storage == Memory_estimate::seasons_raw)
+		generate_climate(planet, climate, c);
+	else if (storage == Memory_estimate::seasons_compressed) {
+		init_compressed_climate(compressed, planet, default_keyframe_interval);
+		generate_climate(planet, climate, [&](int, const Season& s) {append_season(compressed, s);}, c);
+		m_climate(planet).seasons.resize(compressed.seasons.size());
+		decode_season(decoder, compressed, 0, m_season(planet, 0));
+	}
+	else
+		generate_climate(planet, climate, [](int, const Season&) {}, c);
+
+	Planet_colours colours;
+	init_colours(colours, planet);
+	set_colours(colours, planet, Planet_colours::TOPOGRAPHY);
+	if (storage != Memory_estimate::seasons_streamed) {
+		for (int n=0; n<std::min(season_count(planet), cached_season_attributes); n++) {
+			// compressed seasons are decoded one at a time, as in the gui
+			if (storage == Memory_estimate::seasons_compressed && n > 0) {
+				m_season(planet, n-1) = Season();
+				decode_season(decoder, compressed, n, m_season(planet, n));
+			}
+			set_colours(colours, planet, &nth_season(planet, n), Planet_colours::TEMPERATURE);
+		}
+	}
+	Hammer_projection projection;
+	create_geometry(projection, planet, rotation_to_default(planet));
+}
+
+void _release_free_memory () {
+#ifdef __GLIBC__
+	malloc_trim(0);
+#endif
+}
+
+int memory_command (const Options& o) {
+	std::vector<int> sizes;
+	for (const std::string& size : list_option(o, "sizes"))
+		sizes.push_back(std::atoi(size.c_str()));
+	if (sizes.empty())
+		sizes = {3, 4, 5, 6, 7};
+	Terrain_parameters terrain = terrain_parameters(o);
+	Climate_parameters climate = climate_parameters(o);
+	climate.correct_values();
+	int storage = season_storage(string_option(o, "storage", "raw"));
+	if (storage < 0) {
+		std::cerr << "unknown season storage\n";
+		return 1;
+	}
+	bool measure = has_option(o, "measure");
+	if (measure && !reset_peak_resident())
+		std::cerr << "the peak resident size can't be reset, measured peaks include earlier sizes\n";
+
+	std::cout << "seasons: " << climate.seasons << ", iterations: " << terrain.iterations
+		<< ", storage: " << string_option(o, "storage", "raw") << ", megabytes\n"
+		<< "size      tiles     grid  terrain  seasons generation  render predicted";
+	if (measure)
+		std::cout << " measured    ratio";
+	std::cout << "\n" << std::fixed << std::setprecision(1);
+	int exceeded = 0;
+	for (int size : sizes) {
+		terrain.grid_size = size;
+		terrain.correct_values();
+		Memory_estimate m = estimate_memory(terrain.grid_size, terrain.iterations, climate.seasons, storage);
+		std::cout << std::setw(4) << terrain.grid_size << std::setw(11) << tile_count(terrain.grid_size)
+			<< std::setw(9) << _megabytes(m.grid) << std::setw(9) << _megabytes(m.terrain)
+			<< std::setw(9) << _megabytes(m.seasons) << std::setw(11) << _megabytes(m.generation)
+			<< std::setw(8) << _megabytes(m.render) << std::setw(10) << _megabytes(peak_bytes(m));
+		if (!within_memory_budget(m)) {
+			std::cout << "  over budget\n";
+			exceeded++;
+			continue;
+		}
+		if (measure) {
+			// growth of the peak resident size over what the process held before
+			_release_free_memory();
+			reset_peak_resident();
+			size_t before = resident_bytes();
+			_generate_measured(terrain, climate, storage);
+			double measured = (double)peak_resident_bytes() - before;
+			std::cout << std::setw(9) << _megabytes(measured) << std::setw(9) << std::setprecision(2)
+				<< measured / peak_bytes(m) << std::setprecision(1);
+			_release_free_memory();
+		}
+		std::cout << "\n";
+	}
+	if (memory_budget() > 0)
+		std::cout << "budget: " << _megabytes(memory_budget()) << " MB, " << exceeded << " of " << sizes.size() << " sizes over it\n";
+	return 0;
+}
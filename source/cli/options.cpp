@@ -0,0 +1,82 @@
+#include "options.h"
+#include "../planet/terrain/terrain_parameters.h"
+#include "../planet/climate/climate_parameters.h"
+#include "../render/planet_colours.h"
+#include <cstdlib>
+
+Options::Options (int argc, char** argv, int first) {
+	for (int i=first; i<argc; i++) {
+		std::string arg = argv[i];
+		if (arg.compare(0, 2, "--") != 0)
+			continue;
+		std::string value = "";
+		if (i+1 < argc && std::string(argv[i+1]).compare(0, 2, "--") != 0) {
+			value = argv[i+1];
+			i++;
+		}
+		values[arg.substr(2)] = value;
+	}
+}
+
+bool has_option (const Options& o, const std::string& name) {
+	return o.values.find(name) != o.values.end();
+}
+
+std::string string_option (const Options& o, const std::string& name, const std::string& default_value) {
+	auto found = o.values.find(name);
+	return found == o.values.end() ? default_value : found->second;
+}
+
+int int_option (const Options& o, const std::string& name, int default_value) {
+	auto found = o.values.find(name);
+	return found == o.values.end() ? default_value : std::atoi(found->second.c_str());
+}
+
+double real_option (const Options& o, const std::string& name, double default_value) {
+	auto found = o.values.find(name);
+	return found == o.values.end() ? default_value : std::atof(found->second.c_str());
+}
+
+std::vector<std::string> list_option (const Options& o, const std::string& name) {
+	std::vector<std::string> list;
+	auto found = o.values.find(name);
+	if (found == o.values.end())
+		return list;
+	std::string value = found->second;
+	size_t start = 0;
+	while (start <= value.size()) {
+		size_t end = value.find(',', start);
+		if (end == std::string::npos)
+			end = value.size();
+		if (end > start)
+			list.push_back(value.substr(start, end - start));
+		start = end + 1;
+	}
+	return list;
+}
+
+Terrain_parameters terrain_parameters (const Options& o) {
+	Terrain_parameters par;
+	par.seed = string_option(o, "seed", "earthgen");
+	par.grid_size = int_option(o, "size", par.grid_size);
+	par.iterations = int_option(o, "iterations", par.iterations);
+	par.water_ratio = real_option(o, "water", par.water_ratio);
+	par.correct_values();
+	return par;
+}
+
+Climate_parameters climate_parameters (const Options& o) {
+	Climate_parameters par;
+	par.seasons = int_option(o, "seasons", par.seasons);
+	par.axial_tilt = real_option(o, "tilt", par.axial_tilt);
+	par.correct_values();
+	return par;
+}
+
+int colour_mode (const std::string& name) {
+	static const char* names[6] = {"topography", "vegetation", "temperature", "aridity", "humidity", "precipitation"};
+	for (int i=0; i<6; i++)
+		if (name == names[i])
+			return Planet_colours::TOPOGRAPHY + i;
+	return -1;
+}
@@ -0,0 +1,30 @@
+#ifndef options_h
+#define options_h
+
+#include <map>
+#include <string>
+#include <vector>
+class Terrain_parameters;
+class Climate_parameters;
+
+// command line options of the form --name value
+class Options {
+public:
+	Options (int argc, char** argv, int first);
+
+	std::map<std::string, std::string> values;
+};
+
+bool has_option (const Options&, const std::string&);
+std::string string_option (const Options&, const std::string&, const std::string&);
+int int_option (const Options&, const std::string&, int);
+double real_option (const Options&, const std::string&, double);
+// comma separated values, empty if the option is missing
+std::vector<std::string> list_option (const Options&, const std::string&);
+
+Terrain_parameters terrain_parameters (const Options&);
+Climate_parameters climate_parameters (const Options&);
+// colour mode by name, -1 if unknown
+int colour_mode (const std::string&);
+
+#endif
@@ -0,0 +1,59 @@
+#include "commands.h"
+#include "options.h"
+#include "../planet/planet.h"
+#include "../planet/planet_cache.h"
+#include "../planet/planet_memory.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../io/raster_export.h"
+#include "timer.h"
+#include <iostream>
+
+int raster_command (const Options& o) {
+	std::string field = string_option(o, "field", "elevation");
+	std::string projection = string_option(o, "projection", "equirectangular");
+	if (projection != "equirectangular" && projection != "cube") {
+		std::cerr << "unknown projection\n";
+		return 1;
+	}
+	Raster_export e;
+	e.projection = projection == "cube" ? Raster_export::cube_map : Raster_export::equirectangular;
+	e.width = int_option(o, "width", 8192);
+	std::string output = string_option(o, "output", "planet.pfm");
+
+	Terrain_parameters terrain = terrain_parameters(o);
+	Climate_parameters climate = climate_parameters(o);
+	int season_index = int_option(o, "season", 0);
+	if (field != "elevation" && (season_index < 0 || season_index >= climate.seasons)) {
+		std::cerr << "season has to be from 0 to " << climate.seasons - 1 << "\n";
+		return 1;
+	}
+	if (!check_memory_budget(terrain, field == "elevation" ? 0 : climate.seasons, Memory_estimate::seasons_raw))
+		return 1;
+
+	Planet planet;
+	Raster_field values;
+	if (field == "elevation") {
+		cached_terrain(planet, terrain);
+		elevation_field(values, planet);
+	}
+	else {
+		cached_planet(planet, terrain, climate);
+		const Season& season = nth_season(planet, season_index);
+		if (!season_field(values, planet, season, field)) {
+			std::cerr << "unknown field\n";
+			return 1;
+		}
+	}
+
+	Time_point start = now();
+	if (!export_raster(output, e, planet, values)) {
+		std::cerr << "could not write " << output << "\n";
+		return 1;
+	}
+	double time = seconds_since(start);
+	std::cout
+		<< raster_width(e) << " x " << raster_height(e) << " pixels\n"
+		<< "time: " << time << " s, " << raster_width(e) * (double)raster_height(e) / time / 1.0e6 << " Mpixels/s\n";
+	return 0;
+}
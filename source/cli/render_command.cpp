@@ -0,0 +1,91 @@
+#include "commands.h"
+#include "options.h"
+#include "../planet/planet.h"
+#include "../planet/planet_cache.h"
+#include "../planet/planet_memory.h"
+#include "../planet/terrain/terrain_generation.h"
+#include "../planet/climate/climate_generation.h"
+#include "../render/planet_colours.h"
+#include "../render/hammer_projection.h"
+#include "../render/software_renderer.h"
+#include "../render/image.h"
+#include "../io/png.h"
+#include "../thread/parallel.h"
+#include "timer.h"
+#include <iostream>
+
+void view_geometry (Raster_geometry& geometry, const Planet& planet, const Options& o, const std::string& view, int width, int height) {
+	if (view == "map") {
+		Hammer_projection projection;
+		create_geometry(projection, planet, rotation_to_default(planet));
+		map_geometry(geometry, projection, width, height);
+	}
+	else {
+		Quaternion q = globe_rotation(real_option(o, "latitude", 0), real_option(o, "longitude", 0));
+		globe_geometry(geometry, planet, q * rotation_to_default(planet), width, height);
+	}
+}
+
+int render_command (const Options& o) {
+	std::string view = string_option(o, "view", "map");
+	int mode = colour_mode(string_option(o, "colour", "topography"));
+	if (mode < 0 || (view != "map" && view != "globe")) {
+		std::cerr << "unknown colour mode or view\n";
+		return 1;
+	}
+	int width = int_option(o, "width", 2048);
+	int height = int_option(o, "height", view == "map" ? width/2 : width);
+	if (width < 1 || height < 1) {
+		std::cerr << "width and height have to be at least 1\n";
+		return 1;
+	}
+	std::string output = string_option(o, "output", "planet.png");
+
+	Terrain_parameters terrain = terrain_parameters(o);
+	Climate_parameters climate = climate_parameters(o);
+	bool topography = mode == Planet_colours::TOPOGRAPHY;
+	int season_index = int_option(o, "season", 0);
+	if (!topography && (season_index < 0 || season_index >= climate.seasons)) {
+		std::cerr << "season has to be from 0 to " << climate.seasons - 1 << "\n";
+		return 1;
+	}
+	if (!check_memory_budget(terrain, topography ? 0 : climate.seasons, Memory_estimate::seasons_raw))
+		return 1;
+
+	Planet planet;
+	const Season* season = nullptr;
+	if (topography)
+		cached_terrain(planet, terrain);
+	else {
+		cached_planet(planet, terrain, climate);
+		season = &nth_season(planet, season_index);
+	}
+	Planet_colours colours;
+	init_colours(colours, planet);
+	set_colours(colours, planet, season, mode);
+
+	Time_point start = now();
+	Raster_geometry geometry;
+	view_geometry(geometry, planet, o, view, width, height);
+	double geometry_time = seconds_since(start);
+
+	start = now();
+	Image image(width, height);
+	draw_tiles(image, geometry, colours);
+	double raster_time = seconds_since(start);
+
+	start = now();
+	if (!write_png(output, image)) {
+		std::cerr << "could not write " << output << "\n";
+		return 1;
+	}
+	double png_time = seconds_since(start);
+
+	double megapixels = (double)width * height / 1.0e6;
+	std::cout
+		<< "threads: " << thread_count() << "\n"
+		<< "geometry: " << geometry_time << " s\n"
+		<< "rasterization: " << raster_time << " s, " << megapixels / raster_time << " megapixels/s\n"
+		<< "png: " << png_time << " s, " << megapixels / png_time << " megapixels/s\n";
+	return 0;
+}
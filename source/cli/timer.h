@@ -0,0 +1,16 @@
+#ifndef timer_h
+#define timer_h
+
+#include <chrono>
+
+typedef std::chrono::steady_clock::time_point Time_point;
+
+inline Time_point now () {
+	return std::chrono::steady_clock::now();
+}
+
+inline double seconds_since (const Time_point& start) {
+	return std::chrono::duration<double>(now() - start).count();
+}
+
+#endif
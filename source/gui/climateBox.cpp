@@ -2,7 +2,10 @@
 #include <QPushButton>
 #include <QFormLayout>
 #include <QLineEdit>
+#include <QCheckBox>
+#include <QMessageBox>
 #include "planetHandler.h"
+#include "../planet/planet_memory.h"
 
 ClimateBox::ClimateBox (PlanetHandler* p) : QGroupBox(QString("Climate")), planetHandler(p) {
 	form = new QFormLayout();
@@ -12,6 +15,10 @@ ClimateBox::ClimateBox (PlanetHandler* p) : QGroupBox(QString("Climate")), plane
 		axialTiltEdit = new QLineEdit();
 		form->addRow("Axial tilt", axialTiltEdit);
 
+		compressBox = new QCheckBox("Compress in memory");
+		QObject::connect(compressBox, SIGNAL(toggled(bool)), this, SLOT(compressChanged(bool)));
+		form->addWidget(compressBox);
+
 		generateButton = new QPushButton("Generate");
 		generateButton->setEnabled(false);
 		QObject::connect(generateButton, SIGNAL(clicked()), this, SLOT(generateButtonClicked()));
@@ -29,6 +36,20 @@ void ClimateBox::generateButtonClicked () {
 
 	par.correct_values();
 	setValues(par);
+	// seasons are compressed when that is what fits the budget, the gui can't stream them
+	int size = planetHandler->planet().grid->size;
+	int preferred = compressBox->isChecked() ? Memory_estimate::seasons_compressed : Memory_estimate::seasons_raw;
+	int storage = fitting_season_storage(size, 0, par.seasons, preferred);
+	if (storage < 0 || storage == Memory_estimate::seasons_streamed) {
+		Memory_estimate m = estimate_memory(size, 0, par.seasons, Memory_estimate::seasons_compressed);
+		QMessageBox::warning(this, "Generate climate", QString("%1 seasons need about %2 MB even compressed, over the memory budget of %3 MB.")
+			.arg(par.seasons).arg(peak_bytes(m) / (1024*1024), 0, 'f', 1).arg(memory_budget() / (1024*1024), 0, 'f', 1));
+		return;
+	}
+	if (storage != preferred) {
+		compressBox->setChecked(true);
+		QMessageBox::information(this, "Generate climate", "The seasons don't fit the memory budget uncompressed and will be compressed in memory.");
+	}
 	planetHandler->generateClimate(par);
 }
 
@@ -37,6 +58,10 @@ void ClimateBox::setValues (const Climate_parameters& par) {
 	axialTiltEdit->setText(QString::number((double)par.axial_tilt));
 }
 
+void ClimateBox::compressChanged (bool compress) {
+	planetHandler->setCompressSeasons(compress);
+}
+
 void ClimateBox::enableButton () {
 	generateButton->setEnabled(true);
 }
@@ -5,6 +5,7 @@
 class QPushButton;
 class QFormLayout;
 class QLineEdit;
+class QCheckBox;
 class PlanetHandler;
 class Climate_parameters;
 
@@ -16,6 +17,7 @@ public slots:
 	void generateButtonClicked ();
 	void enableButton ();
 	void disableButton ();
+	void compressChanged (bool);
 private:
 	void setValues (const Climate_parameters&);
 
@@ -24,6 +26,7 @@ public:
 	QPushButton* generateButton;
 	QLineEdit* seasonsEdit;
 	QLineEdit* axialTiltEdit;
+	QCheckBox* compressBox;
 	PlanetHandler* planetHandler;
 };
 
@@ -5,9 +5,12 @@
 #include <QComboBox>
 #include <QLineEdit>
 #include <QLabel>
+#include <QTimer>
+#include <QElapsedTimer>
 #include "planetHandler.h"
 #include "planetWidget.h"
 #include "../render/planet_colours.h"
+#include "../render/season_animation.h"
 #include <iostream>
 
 DisplayBox::DisplayBox (PlanetHandler* p, PlanetWidget* w) : QGroupBox(QString("Display")), planetHandler(p), planetWidget(w) {
@@ -45,17 +48,35 @@ DisplayBox::DisplayBox (PlanetHandler* p, PlanetWidget* w) : QGroupBox(QString("
 			incrementSeasonButton->setEnabled(false);
 			QObject::connect(incrementSeasonButton, SIGNAL(clicked()), this, SLOT(incrementSeason()));
 			seasonButtonLayout->addWidget(incrementSeasonButton, 0, 1, 1, 1);
+			playButton = new QPushButton("Play");
+			playButton->setCheckable(true);
+			playButton->setEnabled(false);
+			QObject::connect(playButton, SIGNAL(clicked()), this, SLOT(playButtonClicked()));
+			seasonButtonLayout->addWidget(playButton, 0, 2, 1, 1);
 		layout->addLayout(seasonButtonLayout, 2, 2, 1, 1);
 	setLayout(layout);
 
 	terrainEnabled = false;
 	climateEnabled = false;
 
+	animation = new Season_animation();
+	animationClock = new QElapsedTimer();
+	animationTime = 0;
+	animationTimer = new QTimer(this);
+	animationTimer->setInterval(1000 / framesPerSecond);
+	QObject::connect(animationTimer, SIGNAL(timeout()), this, SLOT(animationFrame()));
+
+	QObject::connect(planetHandler, SIGNAL(planetChanging()), this, SLOT(stopAnimation()));
 	QObject::connect(planetHandler, SIGNAL(terrainCreated()), this, SLOT(enableTerrain()));
 	QObject::connect(planetHandler, SIGNAL(climateCreated()), this, SLOT(enableClimate()));
 	QObject::connect(planetHandler, SIGNAL(climateDestroyed()), this, SLOT(disableClimate()));
 }
 
+DisplayBox::~DisplayBox () {
+	delete animation;
+	delete animationClock;
+}
+
 void DisplayBox::mapButtonClicked () {
 	mapButton->setChecked(true);
 	globeButton->setChecked(false);
@@ -70,8 +91,15 @@ void DisplayBox::globeButtonClicked () {
 }
 
 void DisplayBox::colourChanged () {
-	set_colours(*planetWidget->colours, planetHandler->planet(), planetHandler->currentSeason(), colourBox->currentIndex());
-	planetWidget->update();
+	if (animationTimer->isActive()) {
+		if (colourBox->currentIndex() != Planet_colours::TOPOGRAPHY) {
+			startAnimation();
+			return;
+		}
+		setSeason((int)animationTime);
+		return;
+	}
+	planetWidget->setColours(planetHandler->currentSeason(), colourBox->currentIndex());
 }
 
 void DisplayBox::enableTerrain () {
@@ -89,6 +117,7 @@ void DisplayBox::enableClimate () {
 		seasonEdit->setText("0");
 		decrementSeasonButton->setEnabled(true);
 		incrementSeasonButton->setEnabled(true);
+		playButton->setEnabled(true);
 		colourBox->insertItem(1, "Vegetation");
 		colourBox->insertItem(2, "Temperature");
 		colourBox->insertItem(3, "Aridity");
@@ -105,6 +134,7 @@ void DisplayBox::disableClimate () {
 	seasonEdit->setText("");
 	decrementSeasonButton->setEnabled(false);
 	incrementSeasonButton->setEnabled(false);
+	playButton->setEnabled(false);
 	colourBox->setCurrentIndex(0);
 	int removeFrom = 1;
 	while (colourBox->count() > removeFrom)
@@ -113,6 +143,7 @@ void DisplayBox::disableClimate () {
 }
 
 void DisplayBox::setSeason (int s) {
+	stopAnimation();
 	currentSeason = s;
 	planetHandler->setCurrentSeason(currentSeason);
 	seasonEdit->setText(QString::number(currentSeason));
@@ -120,9 +151,64 @@ void DisplayBox::setSeason (int s) {
 }
 
 void DisplayBox::incrementSeason () {
+	if (season_count(planetHandler->planet()) == 0)
+		return;
 	setSeason((currentSeason+1) % season_count(planetHandler->planet()));
 }
 
 void DisplayBox::decrementSeason () {
+	if (season_count(planetHandler->planet()) == 0)
+		return;
 	setSeason(currentSeason - 1 < 0 ? season_count(planetHandler->planet()) - 1 : currentSeason - 1);
 }
+
+void DisplayBox::playButtonClicked () {
+	if (season_count(planetHandler->planet()) == 0) {
+		stopAnimation();
+		return;
+	}
+	if (animationTimer->isActive()) {
+		setSeason((int)(animationTime + 0.5) % season_count(planetHandler->planet()));
+	}
+	else {
+		animationTime = currentSeason;
+		// topography is the same in every season
+		if (colourBox->currentIndex() == Planet_colours::TOPOGRAPHY)
+			colourBox->setCurrentIndex(Planet_colours::VEGETATION);
+		startAnimation();
+	}
+}
+
+// restarts computation of season colours in the current mode, frames are shown as soon as they are ready
+void DisplayBox::startAnimation () {
+	// compressed seasons are decoded one at a time by the animation rather than all kept decoded
+	if (!planetHandler->loadFileSeasons()) {
+		stopAnimation();
+		return;
+	}
+	start_animation(*animation, planetHandler->planet(), colourBox->currentIndex(), planetHandler->compressedClimate());
+	playButton->setChecked(true);
+	animationClock->start();
+	animationTimer->start();
+}
+
+void DisplayBox::stopAnimation () {
+	animationTimer->stop();
+	playButton->setChecked(false);
+	stop_animation(*animation);
+}
+
+void DisplayBox::animationFrame () {
+	if (season_count(planetHandler->planet()) == 0) {
+		stopAnimation();
+		return;
+	}
+	double elapsed = animationClock->restart() * 1.0e-3;
+	double time = animationTime + elapsed * season_count(planetHandler->planet()) / secondsPerYear;
+	time = std::fmod(time, (double)season_count(planetHandler->planet()));
+	// hold the current frame until the seasons it blends are computed
+	if (!planetWidget->setAnimationFrame(animation, time))
+		return;
+	animationTime = time;
+	seasonEdit->setText(QString::number((int)time));
+}
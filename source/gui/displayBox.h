@@ -8,11 +8,15 @@ class QComboBox;
 class QLineEdit;
 class PlanetHandler;
 class PlanetWidget;
+class QTimer;
+class QElapsedTimer;
+class Season_animation;
 
 class DisplayBox : public QGroupBox {
 	Q_OBJECT
 public:
 	DisplayBox (PlanetHandler*, PlanetWidget*);
+	~DisplayBox ();
 public slots:
 	void mapButtonClicked ();
 	void globeButtonClicked ();
@@ -23,6 +27,10 @@ public slots:
 	void setSeason (int);
 	void incrementSeason ();
 	void decrementSeason ();
+	void playButtonClicked ();
+	void startAnimation ();
+	void stopAnimation ();
+	void animationFrame ();
 public:
 	QGridLayout* layout;
 	QPushButton* mapButton;
@@ -31,11 +39,20 @@ public:
 	QLineEdit* seasonEdit;
 	QPushButton* incrementSeasonButton;
 	QPushButton* decrementSeasonButton;
+	QPushButton* playButton;
+	QTimer* animationTimer;
+	QElapsedTimer* animationClock;
+	Season_animation* animation;
+	// position in the year, in seasons
+	double animationTime;
 	PlanetHandler* planetHandler;
 	PlanetWidget* planetWidget;
 	bool terrainEnabled;
 	bool climateEnabled;
 	int currentSeason;
+
+	static const int framesPerSecond = 60;
+	static const int secondsPerYear = 8;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "fileBox.h"
+#include <QPushButton>
+#include <QGridLayout>
+#include <QFileDialog>
+#include <QMessageBox>
+#include "planetHandler.h"
+
+FileBox::FileBox (PlanetHandler* p) : QGroupBox(QString("File")), planetHandler(p) {
+	layout = new QGridLayout();
+		saveButton = new QPushButton("Save");
+		saveButton->setEnabled(false);
+		QObject::connect(saveButton, SIGNAL(clicked()), this, SLOT(saveButtonClicked()));
+		layout->addWidget(saveButton, 0, 0, 1, 1);
+
+		loadButton = new QPushButton("Load");
+		QObject::connect(loadButton, SIGNAL(clicked()), this, SLOT(loadButtonClicked()));
+		layout->addWidget(loadButton, 0, 1, 1, 1);
+	setLayout(layout);
+
+	QObject::connect(planetHandler, SIGNAL(terrainCreated()), this, SLOT(enableSave()));
+}
+
+void FileBox::saveButtonClicked () {
+	QString name = QFileDialog::getSaveFileName(this, "Save planet", QString(), "Planets (*.planet)");
+	if (name.isEmpty())
+		return;
+	if (!planetHandler->savePlanet(name))
+		QMessageBox::warning(this, "Save planet", "Could not write " + name);
+}
+
+void FileBox::loadButtonClicked () {
+	QString name = QFileDialog::getOpenFileName(this, "Load planet", QString(), "Planets (*.planet)");
+	if (name.isEmpty())
+		return;
+	if (!planetHandler->loadPlanet(name))
+		QMessageBox::warning(this, "Load planet", "Could not read " + name);
+}
+
+void FileBox::enableSave () {
+	saveButton->setEnabled(true);
+}
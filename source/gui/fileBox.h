@@ -0,0 +1,25 @@
+#ifndef file_box_h
+#define file_box_h
+
+#include <QGroupBox>
+class QPushButton;
+class QGridLayout;
+class PlanetHandler;
+
+class FileBox : public QGroupBox {
+	Q_OBJECT
+public:
+	FileBox (PlanetHandler*);
+public slots:
+	void saveButtonClicked ();
+	void loadButtonClicked ();
+	void enableSave ();
+
+public:
+	QGridLayout* layout;
+	QPushButton* saveButton;
+	QPushButton* loadButton;
+	PlanetHandler* planetHandler;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#include "generationBox.h"
+#include <QGridLayout>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include "planetHandler.h"
+
+GenerationBox::GenerationBox (PlanetHandler* p) : QGroupBox(QString("Generation")), planetHandler(p) {
+	layout = new QGridLayout();
+		stageLabel = new QLabel("");
+		layout->addWidget(stageLabel, 0, 0, 1, 2);
+
+		progressBar = new QProgressBar();
+		progressBar->setRange(0, 100);
+		layout->addWidget(progressBar, 1, 0, 1, 1);
+
+		cancelButton = new QPushButton("Cancel");
+		QObject::connect(cancelButton, SIGNAL(clicked()), planetHandler, SLOT(cancelGeneration()));
+		layout->addWidget(cancelButton, 1, 1, 1, 1);
+	setLayout(layout);
+	setVisible(false);
+
+	QObject::connect(planetHandler, SIGNAL(generationProgress(QString, double)), this, SLOT(setProgress(QString, double)));
+	QObject::connect(planetHandler, SIGNAL(generationFinished(bool)), this, SLOT(finish(bool)));
+}
+
+void GenerationBox::setProgress (QString stage, double fraction) {
+	// progress still queued from a generation that was stopped arrives after it finished
+	if (!planetHandler->generating())
+		return;
+	stageLabel->setText(stage);
+	progressBar->setValue((int)(100 * fraction));
+	setVisible(true);
+}
+
+void GenerationBox::finish (bool) {
+	setVisible(false);
+}
@@ -0,0 +1,29 @@
+#ifndef generation_box_h
+#define generation_box_h
+
+#include <QGroupBox>
+#include <QString>
+class QGridLayout;
+class QLabel;
+class QProgressBar;
+class QPushButton;
+class PlanetHandler;
+
+// progress of the generation running in the background, hidden while there is none
+class GenerationBox : public QGroupBox {
+	Q_OBJECT
+public:
+	GenerationBox (PlanetHandler*);
+public slots:
+	void setProgress (QString, double);
+	void finish (bool);
+
+public:
+	QGridLayout* layout;
+	QLabel* stageLabel;
+	QProgressBar* progressBar;
+	QPushButton* cancelButton;
+	PlanetHandler* planetHandler;
+};
+
+#endif
@@ -4,6 +4,8 @@
 #include "axisBox.h"
 #include "climateBox.h"
 #include "displayBox.h"
+#include "fileBox.h"
+#include "generationBox.h"
 #include "planetHandler.h"
 
 MainMenu::MainMenu (PlanetHandler* p, PlanetWidget* planetWidget) : planetHandler(p) {
@@ -24,6 +26,14 @@ MainMenu::MainMenu (PlanetHandler* p, PlanetWidget* planetWidget) : planetHandle
 		displayBox = new DisplayBox(planetHandler, planetWidget);
 		displayBox->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Fixed);
 		layout->addWidget(displayBox);
+
+		fileBox = new FileBox(planetHandler);
+		fileBox->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Fixed);
+		layout->addWidget(fileBox);
+
+		generationBox = new GenerationBox(planetHandler);
+		generationBox->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Fixed);
+		layout->addWidget(generationBox);
 	setLayout(layout);
 	setMinimumWidth(200);
 	setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Ignored);
@@ -7,6 +7,8 @@ class TerrainBox;
 class AxisBox;
 class ClimateBox;
 class DisplayBox;
+class FileBox;
+class GenerationBox;
 class PlanetHandler;
 class PlanetWidget;
 
@@ -18,6 +20,8 @@ public:
 	AxisBox* axisBox;
 	ClimateBox* climateBox;
 	DisplayBox* displayBox;
+	FileBox* fileBox;
+	GenerationBox* generationBox;
 	QBoxLayout* layout;
 	PlanetHandler* planetHandler;
 };
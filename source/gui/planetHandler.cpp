@@ -1,12 +1,30 @@
 #include "planetHandler.h"
 #include "planetWidget.h"
+#include "../io/planet_file.h"
+#include "../planet/planet_cache.h"
+#include "../planet/generation_context.h"
+#include <algorithm>
 #include <iostream>
 
 PlanetHandler::PlanetHandler () {
 	_currentSeason = 0;
+	_file = nullptr;
+	_compressSeasons = false;
+	_decodedSeason = -1;
+	_terrainKnown = false;
+	_generating = noGeneration;
+	_generationId = 0;
+	_cancel = false;
+	_completed = false;
+	_pendingCached = false;
+	// the worker's signal is handled on the gui thread, where the planet is read
+	QObject::connect(this, SIGNAL(workerDone(int)), this, SLOT(publishGeneration(int)), Qt::QueuedConnection);
+	QObject::connect(this, SIGNAL(previewDone(int)), this, SLOT(publishPreview(int)), Qt::QueuedConnection);
 }
 
 PlanetHandler::~PlanetHandler () {
+	stopGeneration();
+	delete _file;
 }
 
 void PlanetHandler::setCurrentSeason (int n) {
@@ -16,27 +34,264 @@ void PlanetHandler::setCurrentSeason (int n) {
 const Season* PlanetHandler::currentSeason () {
 	if (_currentSeason >= planet().climate->seasons.size())
 		return nullptr;
+	if (_file && !load_season(_planet, *_file, _currentSeason))
+		return nullptr;
+	if (!_compressed.seasons.empty() && !season_loaded(_planet, _currentSeason)) {
+		releaseSeason(_decodedSeason);
+		decode_season(_decoder, _compressed, _currentSeason, m_season(_planet, _currentSeason));
+		_decodedSeason = _currentSeason;
+	}
 	return &nth_season(planet(), _currentSeason);
 }
 
+bool PlanetHandler::loadFileSeasons () {
+	bool loaded = true;
+	if (_file) {
+		for (int i=0; i<season_count(_planet); i++)
+			loaded = load_season(_planet, *_file, i) && loaded;
+	}
+	return loaded;
+}
+
+bool PlanetHandler::loadSeasons () {
+	bool loaded = loadFileSeasons();
+	if (!_compressed.seasons.empty()) {
+		for (int i=0; i<season_count(_planet); i++)
+			if (!season_loaded(_planet, i))
+				loaded = decode_season(_decoder, _compressed, i, m_season(_planet, i)) && loaded;
+		_decodedSeason = -1;
+	}
+	return loaded;
+}
+
+bool PlanetHandler::savePlanet (const QString& name) {
+	// the file may be the one mapped, so everything is read from it before it is overwritten
+	if (!loadSeasons())
+		return false;
+	closeFile();
+	// seasons compressed in memory are saved compressed
+	int keyframe_interval = _compressed.seasons.empty() ? 0 : _compressed.keyframe_interval;
+	return save_planet(name.toStdString(), _planet, keyframe_interval);
+}
+
+bool PlanetHandler::loadPlanet (const QString& name) {
+	Planet_file* file = new Planet_file();
+	if (!open_planet_file(*file, name.toStdString())) {
+		delete file;
+		return false;
+	}
+	stopGeneration();
+	planetChanging();
+	closeFile();
+	clearCompressed();
+	_terrainKnown = false;
+	climateDestroyed();
+	if (!load_planet(_planet, *file)) {
+		delete file;
+		clear(_planet);
+		terrainCreated();
+		axisChanged();
+		return false;
+	}
+	_file = file;
+	terrainCreated();
+	axisChanged();
+	if (season_count(_planet) > 0)
+		climateCreated();
+	return true;
+}
+
+void PlanetHandler::setCompressSeasons (bool compress) {
+	_compressSeasons = compress;
+}
+
+void PlanetHandler::closeFile () {
+	delete _file;
+	_file = nullptr;
+}
+
+void PlanetHandler::clearCompressed () {
+	_compressed = Compressed_climate();
+	_decoder = Season_decoder();
+	_decodedSeason = -1;
+}
+
+void PlanetHandler::releaseSeason (int n) {
+	if (n >= 0 && n < season_count(_planet))
+		m_season(_planet, n) = Season();
+}
+
 void PlanetHandler::setAxis (Vector3 v) {
 	if (zero(v)) {
 		v = default_axis();
 	}
+	// a climate being generated reads the axis
+	stopGeneration();
+	planetChanging();
+	closeFile();
+	clearCompressed();
 	m_terrain(_planet).var.axis = normal(v);
+	_terrainParameters.axis = axis(_planet);
 	climateDestroyed();
 	clear_climate(_planet);
 	axisChanged();
 }
 
 void PlanetHandler::generateTerrain (const Terrain_parameters& par) {
+	stopGeneration();
+	// the terrain is generated into a planet of its own, the current one stays displayed
+	_pendingTerrain = par;
+	_previewTerrain = par;
+	_previewTerrain.grid_size = std::min(par.grid_size, preview_grid_size);
+	startGeneration(terrainGeneration, [this] (Generation_context& c) {
+		// made once for both sizes, so the preview has the same continents as the planet
+		auto vectors = _elevation_vectors(_pendingTerrain);
+		if (_pendingTerrain.grid_size > preview_grid_size) {
+			std::function<void (const std::string&, double)> progress = c.progress;
+			Generation_context preview;
+			preview.cancel = c.cancel;
+			preview.progress = [progress] (const std::string& stage, double fraction) {
+				progress("preview " + stage, fraction);
+			};
+			if (!generate_terrain(_previewPlanet, _previewTerrain, vectors, preview))
+				return false;
+			// the preview is left to the gui thread from here on
+			previewDone(_generationId);
+		}
+		return cached_terrain(_pendingPlanet, _pendingTerrain, vectors, c);
+	});
+}
+
+void PlanetHandler::generateClimate (const Climate_parameters& par) {
+	stopGeneration();
+	// the worker reads grid and terrain of the planet, which stay unchanged until it is done
+	planetChanging();
+	closeFile();
+	clearCompressed();
 	climateDestroyed();
-	generate_terrain(_planet, par);
+	init_climate(_planet, par);
+	_pendingClimate = par;
+	bool compress = _compressSeasons;
+	if (compress)
+		init_compressed_climate(_pendingCompressed, _planet, default_keyframe_interval);
+	bool cache = _terrainKnown && !compress && !planet_cache_directory().empty();
+	std::string key = climate_key(_terrainParameters, par);
+	startGeneration(climateGeneration, [this, compress, cache, key] (Generation_context& c) {
+		Planet cached;
+		if (cache && _load_cached(cached, key) && tile_count(cached) == tile_count(_planet)) {
+			_pendingSeasons = climate(cached).seasons;
+			_pendingCached = true;
+			return true;
+		}
+		// progress is reported per season rather than per stage, naming the season being generated
+		c.progress = nullptr;
+		int seasons = _pendingClimate.seasons;
+		generationProgress(QString("season 1 of %1").arg(seasons), 0);
+		return generate_seasons(_planet, _pendingClimate, [this, compress, seasons] (int i, const Season& s) {
+			if (compress)
+				append_season(_pendingCompressed, s);
+			else
+				_pendingSeasons.push_back(s);
+			if (i+1 < seasons)
+				generationProgress(QString("season %1 of %2").arg(i+2).arg(seasons), (i+1.0) / seasons);
+		}, c);
+	});
+}
+
+void PlanetHandler::cancelGeneration () {
+	_cancel = true;
+}
+
+void PlanetHandler::startGeneration (int kind, const std::function<bool (Generation_context&)>& generate) {
+	_generating = kind;
+	_generationId++;
+	_cancel = false;
+	_completed = false;
+	int id = _generationId;
+	_worker = std::thread([this, generate, id] () {
+		Generation_context c;
+		c.cancel = &_cancel;
+		c.progress = [this] (const std::string& stage, double fraction) {
+			generationProgress(QString::fromStdString(stage), fraction);
+		};
+		_completed = generate(c);
+		workerDone(id);
+	});
+}
+
+void PlanetHandler::stopGeneration () {
+	if (!_worker.joinable())
+		return;
+	_cancel = true;
+	_worker.join();
+	// the done signal already queued by the worker is ignored by its id
+	_generationId++;
+	_pendingPlanet = Planet();
+	_previewPlanet = Planet();
+	_pendingSeasons.clear();
+	_pendingCompressed = Compressed_climate();
+	_pendingCached = false;
+	_generating = noGeneration;
+	generationFinished(false);
+}
+
+void PlanetHandler::publishGeneration (int id) {
+	if (id != _generationId)
+		return;
+	_worker.join();
+	int kind = _generating;
+	_generating = noGeneration;
+	bool completed = _completed && !_cancel;
+	if (completed && kind == terrainGeneration)
+		publishTerrain();
+	else if (completed && kind == climateGeneration)
+		publishClimate();
+	_pendingPlanet = Planet();
+	_previewPlanet = Planet();
+	_pendingSeasons.clear();
+	_pendingCompressed = Compressed_climate();
+	_pendingCached = false;
+	generationFinished(completed);
+}
+
+void PlanetHandler::publishPreview (int id) {
+	if (id != _generationId || _cancel)
+		return;
+	// shown as a planet of its own, climates generated for it cancel the full size
+	planetChanging();
+	closeFile();
+	clearCompressed();
+	climateDestroyed();
+	_swap_planet(_planet, _previewPlanet);
+	_previewPlanet = Planet();
+	_terrainParameters = _previewTerrain;
+	_terrainKnown = true;
 	terrainCreated();
 	axisChanged();
 }
 
-void PlanetHandler::generateClimate (const Climate_parameters& par) {
-	generate_climate(_planet, par);
+void PlanetHandler::publishTerrain () {
+	planetChanging();
+	closeFile();
+	clearCompressed();
+	climateDestroyed();
+	_swap_planet(_planet, _pendingPlanet);
+	_terrainParameters = _pendingTerrain;
+	_terrainKnown = true;
+	terrainCreated();
+	axisChanged();
+}
+
+void PlanetHandler::publishClimate () {
+	planetChanging();
+	if (!_pendingCompressed.seasons.empty()) {
+		std::swap(_compressed, _pendingCompressed);
+		m_climate(_planet).seasons.resize(_compressed.seasons.size());
+	}
+	else
+		m_climate(_planet).seasons.swap(_pendingSeasons);
+	m_climate(_planet).var.season_count = climate(_planet).seasons.size();
+	if (_terrainKnown && !_pendingCached && _compressed.seasons.empty() && !planet_cache_directory().empty())
+		_store_cached(_planet, climate_key(_terrainParameters, _pendingClimate));
 	climateCreated();
 }
@@ -2,10 +2,22 @@
 #define planet_handler_h
 
 #include <QObject>
+#include <QString>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
 #include "../math/vector3.h"
 #include "../planet/planet.h"
 #include "../planet/terrain/terrain_generation.h"
 #include "../planet/climate/climate_generation.h"
+#include "../io/season_codec.h"
+class Planet_file;
+class Generation_context;
+
+// larger terrains are first generated and shown at this grid size, then replaced once complete
+const int preview_grid_size = 5;
 
 class PlanetHandler : public QObject {
 	Q_OBJECT
@@ -16,19 +28,87 @@ public:
 	const Planet& planet () const {return _planet;}
 	const Season* currentSeason ();
 	void setCurrentSeason (int);
+	// seasons of a loaded planet are read from its file when first used,
+	// this reads and decodes all of them, as saving needs
+	bool loadSeasons ();
+	// reads the seasons of the mapped file, leaving compressed seasons encoded,
+	// false if any of them can't be read
+	bool loadFileSeasons ();
+	// nullptr unless the climate is kept compressed
+	const Compressed_climate* compressedClimate () const {return _compressed.seasons.empty() ? nullptr : &_compressed;}
+	bool savePlanet (const QString&);
+	bool loadPlanet (const QString&);
+	// climates generated from now on are kept compressed and decoded one season at a time
+	void setCompressSeasons (bool);
+	bool generating () const {return _generating != noGeneration;}
 public slots:
 	void setAxis (Vector3);
+	// both return at once and generate on a worker thread, the planet stays as it is until
+	// the result replaces it. a new generation cancels the one running
 	void generateTerrain (const Terrain_parameters&);
 	void generateClimate (const Climate_parameters&);
+	// the running generation stops at the next check and its result is dropped
+	void cancelGeneration ();
 signals:
+	// emitted before the planet is modified
+	void planetChanging ();
 	void axisChanged ();
 	void terrainCreated ();
 	void climateCreated ();
 	void climateDestroyed ();
+	// from the worker thread, with the stage and the fraction of it done
+	void generationProgress (QString, double);
+	// once the result replaced the planet, or with false once a generation is cancelled
+	void generationFinished (bool);
+	// from the worker thread when it is done, id tells apart generations stopped since
+	void workerDone (int);
+	void previewDone (int);
+
+private slots:
+	void publishGeneration (int);
+	void publishPreview (int);
 
 private:
+	void startGeneration (int, const std::function<bool (Generation_context&)>&);
+	// cancels the running generation and waits for it
+	void stopGeneration ();
+	void publishTerrain ();
+	void publishClimate ();
+	void closeFile ();
+	void clearCompressed ();
+	void releaseSeason (int);
+
 	Planet _planet;
 	unsigned _currentSeason;
+	// file of the loaded planet, nullptr once the planet is modified
+	Planet_file* _file;
+	bool _compressSeasons;
+	// seasons of the current climate when compressed in memory, empty otherwise
+	Compressed_climate _compressed;
+	Season_decoder _decoder;
+	// the only season decoded from _compressed, -1 when none or all are
+	int _decodedSeason;
+	// parameters the terrain was generated with, used as the climate cache key
+	Terrain_parameters _terrainParameters;
+	// false for loaded planets, whose parameters are unknown
+	bool _terrainKnown;
+
+	enum {noGeneration, terrainGeneration, climateGeneration};
+	int _generating;
+	int _generationId;
+	std::thread _worker;
+	std::atomic<bool> _cancel;
+	// results of the worker, only touched by it until it is done
+	bool _completed;
+	Planet _pendingPlanet;
+	Terrain_parameters _pendingTerrain;
+	Planet _previewPlanet;
+	Terrain_parameters _previewTerrain;
+	Climate_parameters _pendingClimate;
+	std::deque<Season> _pendingSeasons;
+	Compressed_climate _pendingCompressed;
+	// whether the climate was read from the planet cache, so it isn't stored again
+	bool _pendingCached;
 };
 
 #endif
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include "../render/globe_renderer.h"
 #include "../render/map_renderer.h"
 #include "../render/planet_colours.h"
+#include "../render/season_animation.h"
+#include "../planet/grid/tile_locator.h"
+#include <QToolTip>
+#include <QElapsedTimer>
 #include <iostream>
 
 PlanetWidget::PlanetWidget (PlanetHandler* p) : planetHandler(p) {
@@ -12,11 +16,19 @@ PlanetWidget::PlanetWidget (PlanetHandler* p) : planetHandler(p) {
 	mapRenderer = new Map_renderer();
 	activeRenderer = emptyRenderer;
 	colours = new Planet_colours();
+	locator = new Tile_locator();
+	hoveredTile = -1;
 	mouseMoving = false;
+	setMouseTracking(true);
+	setFocusPolicy(Qt::StrongFocus);
+	showStatistics = false;
 	
 	QObject::connect(planetHandler, SIGNAL(terrainCreated()), this, SLOT(initColours()));
 	QObject::connect(planetHandler, SIGNAL(terrainCreated()), this, SLOT(updateGeometry()));
+	QObject::connect(planetHandler, SIGNAL(terrainCreated()), this, SLOT(initLocator()));
 	QObject::connect(planetHandler, SIGNAL(axisChanged()), this, SLOT(updateGeometry()));
+	QObject::connect(planetHandler, SIGNAL(climateCreated()), this, SLOT(clearSeasonColours()));
+	QObject::connect(planetHandler, SIGNAL(climateDestroyed()), this, SLOT(clearSeasonColours()));
 }
 
 void PlanetWidget::update () {
@@ -41,10 +53,49 @@ void PlanetWidget::paintGL () {
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	glClearColor(0,0,0,0);
 	if (width() && height()) {
+		bool measure = showStatistics || statisticsLog.is_open();
+		QElapsedTimer timer;
+		timer.start();
+		begin_frame(activeRenderer->statistics);
 		activeRenderer->draw(planetHandler->planet(), rotation_to_default(planetHandler->planet()), *colours);
+		// wait for the gpu, so the frame time includes drawing and not just submitting
+		if (measure)
+			glFinish();
+		end_frame(activeRenderer->statistics, timer.nsecsElapsed() * 1.0e-9);
+		if (showStatistics) {
+			glColor3f(1.0, 1.0, 1.0);
+			renderText(10, 20, QString::fromStdString(summary(activeRenderer->statistics)));
+		}
+		if (statisticsLog.is_open() && activeRenderer->statistics.frames % 60 == 0) {
+			statisticsLog
+				<< (activeRenderer == mapRenderer ? "map" : "globe") << " "
+				<< tile_count(planetHandler->planet()) << " tiles  "
+				<< summary(activeRenderer->statistics) << std::endl;
+		}
 	}
 }
 
+void PlanetWidget::keyPressEvent (QKeyEvent* event) {
+	if (event->key() == Qt::Key_F3)
+		toggleStatistics();
+	else if (event->key() == Qt::Key_F4)
+		toggleStatisticsLog();
+	else
+		QGLWidget::keyPressEvent(event);
+}
+
+void PlanetWidget::toggleStatistics () {
+	showStatistics = !showStatistics;
+	update();
+}
+
+void PlanetWidget::toggleStatisticsLog () {
+	if (statisticsLog.is_open())
+		statisticsLog.close();
+	else
+		statisticsLog.open("earthgen_statistics.log", std::ios::app);
+}
+
 void PlanetWidget::wheelEvent (QWheelEvent* event) {
 	getMousePosition();
 	if(event->orientation() == Qt::Vertical) {
@@ -61,6 +112,9 @@ void PlanetWidget::mousePressEvent (QMouseEvent*) {
 void PlanetWidget::mouseReleaseEvent (QMouseEvent*) {
 	if (!mouseMoving) {
 		pointSelected(conjugate(rotation_to_default(planetHandler->planet())) * activeRenderer->to_coordinates(vector(mousePosition)));
+		int tile = tileAt(mousePosition);
+		if (tile >= 0)
+			tileSelected(tile);
 	}
 	mouseMoving = false;
 }
@@ -74,6 +128,41 @@ void PlanetWidget::mouseMoveEvent (QMouseEvent* event) {
 		mouseMoving = true;
 		mousePosition = newMousePosition;
 	}
+	else if (event->buttons() == Qt::NoButton) {
+		int tile = tileAt(event->pos());
+		if (tile != hoveredTile) {
+			hoveredTile = tile;
+			tileHovered(tile);
+			if (tile >= 0)
+				QToolTip::showText(event->globalPos(), tileDescription(tile), this);
+			else
+				QToolTip::hideText();
+		}
+	}
+}
+
+int PlanetWidget::tileAt (const QPoint& p) {
+	if (locator->cells.size() == 0)
+		return -1;
+	if (activeRenderer == mapRenderer)
+		return mapRenderer->tile_at(vector(p));
+	Vector3 v = activeRenderer->to_coordinates(vector(p));
+	if (zero(v))
+		return -1;
+	v = conjugate(rotation_to_default(planetHandler->planet())) * v;
+	// successive positions are close, so walking from the last tile is usually a step or two
+	if (hoveredTile >= 0 && hoveredTile < tile_count(planetHandler->planet()))
+		return id(find_tile(planetHandler->planet(), v, nth_tile(planetHandler->planet(), hoveredTile)));
+	return id(find_tile(*locator, planetHandler->planet(), v));
+}
+
+QString PlanetWidget::tileDescription (int tile) {
+	const Planet& planet = planetHandler->planet();
+	QString text = QString("Tile %1\nElevation: %2 m").arg(tile).arg(elevation(nth_tile(terrain(planet), tile)) - sea_level(planet), 0, 'f', 0);
+	const Season* season = planetHandler->currentSeason();
+	if (season != nullptr)
+		text += QString("\nTemperature: %1 C").arg(temperature(nth_tile(*season, tile)) - freezing_point(), 0, 'f', 1);
+	return text;
 }
 
 Vector2 PlanetWidget::relativePosition (const QPointF& p) {
@@ -106,4 +195,33 @@ void PlanetWidget::updateGeometry () {
 void PlanetWidget::initColours () {
 	init_colours(*colours, planetHandler->planet());
 	set_colours(*colours, planetHandler->planet(), 0);
+}
+
+void PlanetWidget::setColours (const Season* season, int mode) {
+	QElapsedTimer timer;
+	timer.start();
+	set_colours(*colours, planetHandler->planet(), season, mode);
+	set_colour_update_time(activeRenderer->statistics, timer.nsecsElapsed() * 1.0e-9);
+	if (statisticsLog.is_open())
+		statisticsLog << "colour update " << mode << " " << timer.nsecsElapsed() * 1.0e-6 << " ms" << std::endl;
+	update();
+}
+
+bool PlanetWidget::setAnimationFrame (Season_animation* animation, double time) {
+	QElapsedTimer timer;
+	timer.start();
+	if (!set_frame(*colours, *animation, time))
+		return false;
+	set_colour_update_time(activeRenderer->statistics, timer.nsecsElapsed() * 1.0e-9);
+	update();
+	return true;
+}
+
+void PlanetWidget::initLocator () {
+	init_locator(*locator, planetHandler->planet());
+	hoveredTile = -1;
+}
+
+void PlanetWidget::clearSeasonColours () {
+	clear_season_attributes(*colours);
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <QGLWidget>
 #include <QMouseEvent>
 #include <QWheelEvent>
+#include <QKeyEvent>
+#include <fstream>
 #include "../math/vector2.h"
 #include "../math/vector3.h"
 class PlanetHandler;
@@ -12,6 +14,9 @@ class Globe_renderer;
 class Map_renderer;
 class Empty_renderer;
 class Planet_colours;
+class Tile_locator;
+class Season;
+class Season_animation;
 
 class PlanetWidget : public QGLWidget {
 	Q_OBJECT
@@ -26,18 +31,29 @@ protected:
 	void mousePressEvent (QMouseEvent*);
 	void mouseReleaseEvent (QMouseEvent*);
 	void mouseMoveEvent (QMouseEvent*);
+	void keyPressEvent (QKeyEvent*);
 	void getMousePosition ();
 private:
 	Vector2 relativePosition (const QPointF&);
 	Vector2 vector (const QPoint&) const;
+	int tileAt (const QPoint&);
+	QString tileDescription (int);
 public slots:
 	void update ();
 	void activateGlobeRenderer ();
 	void activateMapRenderer ();
 	void updateGeometry ();
 	void initColours ();
+	void clearSeasonColours ();
+	void initLocator ();
+	void setColours (const Season*, int);
+	bool setAnimationFrame (Season_animation*, double);
+	void toggleStatistics ();
+	void toggleStatisticsLog ();
 signals:
 	void pointSelected (Vector3);
+	void tileSelected (int);
+	void tileHovered (int);
 public:
 	bool mouseMoving;
 	QPoint mousePosition;
@@ -47,6 +63,10 @@ public:
 	Map_renderer* mapRenderer;
 	Empty_renderer* emptyRenderer;
 	Planet_colours* colours;
+	Tile_locator* locator;
+	bool showStatistics;
+	std::ofstream statisticsLog;
+	int hoveredTile;
 };
 
 #endif
\ No newline at end of file
@@ -1,9 +1,11 @@
 #include "terrainBox.h"
 #include <QFormLayout>
 #include <QLineEdit>
+#include <QMessageBox>
 #include <QPushButton>
 #include "planetHandler.h"
 #include "util.h"
+#include "../planet/planet_memory.h"
 
 TerrainBox::TerrainBox (PlanetHandler* p) : QGroupBox("Terrain"), planetHandler(p) {
 	form = new QFormLayout();
@@ -36,6 +38,12 @@ void TerrainBox::generateButtonClicked () {
 
 	par.correct_values();
 	setValues(par);
+	Memory_estimate m = estimate_memory(par.grid_size, par.iterations, 0, Memory_estimate::seasons_raw);
+	if (!within_memory_budget(m)) {
+		QMessageBox::warning(this, "Generate terrain", QString("Grid size %1 needs about %2 MB, over the memory budget of %3 MB.")
+			.arg(par.grid_size).arg(peak_bytes(m) / (1024*1024), 0, 'f', 1).arg(memory_budget() / (1024*1024), 0, 'f', 1));
+		return;
+	}
 	planetHandler->generateTerrain(par);
 }
 
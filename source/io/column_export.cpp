@@ -0,0 +1,91 @@
+#include "column_export.h"
+#include "../planet/planet.h"
+#include <algorithm>
+#include <cstring>
+
+static const char column_file_magic[8] = {'E', 'G', 'C', 'O', 'L', 'U', 'M', 'N'};
+static const char column_file_end[8] = {'E', 'G', 'C', 'O', 'L', 'E', 'N', 'D'};
+
+bool open_column_writer (Column_writer& w, const std::string& name, const Planet& p, int season_count, int chunk_size) {
+	w.out.open(name.c_str(), std::ios::binary);
+	if (!w.out)
+		return false;
+	w.offset = 0;
+	w.chunk_size = std::max(1, chunk_size);
+	w.chunks.clear();
+
+	Column_file_header h;
+	std::memset(&h, 0, sizeof(h));
+	std::memcpy(h.magic, column_file_magic, sizeof(h.magic));
+	h.version = Column_writer::version;
+	h.byte_order = 0x01020304;
+	h.grid_size = p.grid->size;
+	h.tile_count = tile_count(p);
+	h.edge_count = edge_count(p);
+	h.season_count = season_count;
+	w.out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+	w.offset += sizeof(h);
+	return !w.out.fail();
+}
+
+bool close_column_writer (Column_writer& w) {
+	uint64_t count = w.chunks.size();
+	w.out.write(reinterpret_cast<const char*>(w.chunks.data()), count * sizeof(uint64_t));
+	w.out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+	w.out.write(column_file_end, sizeof(column_file_end));
+	w.out.close();
+	std::vector<char>().swap(w.buffer);
+	return !w.out.fail();
+}
+
+void write_column (Column_writer& w, const std::string& name, int season, int count, const std::function<float (int)>& f) {
+	for (int first=0; first<count; first+=w.chunk_size) {
+		int n = std::min(w.chunk_size, count - first);
+		w.buffer.resize(n * sizeof(float));
+		float* values = reinterpret_cast<float*>(w.buffer.data());
+		for (int i=0; i<n; i++)
+			values[i] = f(first + i);
+		_write_chunk(w, name, Column_chunk_header::type_float, season, first, n, values);
+	}
+}
+
+void write_int_column (Column_writer& w, const std::string& name, int season, int count, const std::function<int (int)>& f) {
+	for (int first=0; first<count; first+=w.chunk_size) {
+		int n = std::min(w.chunk_size, count - first);
+		w.buffer.resize(n * sizeof(int32_t));
+		int32_t* values = reinterpret_cast<int32_t*>(w.buffer.data());
+		for (int i=0; i<n; i++)
+			values[i] = f(first + i);
+		_write_chunk(w, name, Column_chunk_header::type_int, season, first, n, values);
+	}
+}
+
+void write_terrain_columns (Column_writer& w, const Planet& p) {
+	const Terrain& t = terrain(p);
+	write_column(w, "tile_latitude", -1, tile_count(p), [&](int i) {return latitude(p, vector(nth_tile(p, i)));});
+	write_column(w, "tile_longitude", -1, tile_count(p), [&](int i) {return longitude(p, vector(nth_tile(p, i)));});
+	write_column(w, "tile_elevation", -1, tile_count(p), [&](int i) {return elevation(nth_tile(t, i));});
+	write_column(w, "tile_water_depth", -1, tile_count(p), [&](int i) {return water_depth(nth_tile(t, i));});
+	write_int_column(w, "tile_type", -1, tile_count(p), [&](int i) {return nth_tile(t, i).type;});
+}
+
+void write_season_columns (Column_writer& w, const Planet& p, const Season& s, int n) {
+	write_column(w, "tile_temperature", n, tile_count(p), [&](int i) {return temperature(nth_tile(s, i));});
+	write_column(w, "tile_humidity", n, tile_count(p), [&](int i) {return humidity(nth_tile(s, i));});
+	write_column(w, "tile_precipitation", n, tile_count(p), [&](int i) {return precipitation(nth_tile(s, i));});
+	write_column(w, "edge_wind_velocity", n, edge_count(p), [&](int i) {return wind_velocity(nth_edge(s, i));});
+}
+
+void _write_chunk (Column_writer& w, const std::string& name, uint32_t type, int season, int first, int count, const void* data) {
+	Column_chunk_header c;
+	std::memset(&c, 0, sizeof(c));
+	std::strncpy(c.column, name.c_str(), sizeof(c.column) - 1);
+	c.type = type;
+	c.season = season;
+	c.first = first;
+	c.count = count;
+	w.chunks.push_back(w.offset);
+	w.out.write(reinterpret_cast<const char*>(&c), sizeof(c));
+	w.out.write(static_cast<const char*>(data), count * 4);
+	w.offset += sizeof(c) + count * 4;
+}
@@ -0,0 +1,67 @@
+#ifndef column_export_h
+#define column_export_h
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+class Planet;
+class Season;
+
+// chunked column file for bulk analysis, written front to back so memory use is one chunk.
+// layout: Column_file_header, then chunks of a Column_chunk_header followed by count values,
+// then the offset of every chunk as uint64, the chunk count as uint64 and the end magic
+class Column_file_header {
+public:
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	int32_t grid_size;
+	int32_t tile_count;
+	int32_t edge_count;
+	int32_t season_count;
+};
+
+class Column_chunk_header {
+public:
+	char column[24];
+	uint32_t type;
+	// -1 for columns that don't vary by season
+	int32_t season;
+	// index of the chunk's first tile or edge
+	uint32_t first;
+	uint32_t count;
+
+	enum {type_float = 1, type_int = 2};
+};
+
+class Column_writer {
+public:
+	Column_writer () :
+		offset (0), chunk_size (65536) {}
+
+	std::ofstream out;
+	uint64_t offset;
+	int chunk_size;
+	std::vector<uint64_t> chunks;
+	std::vector<char> buffer;
+
+	static const uint32_t version = 1;
+};
+
+bool open_column_writer (Column_writer&, const std::string&, const Planet&, int season_count, int chunk_size);
+// writes the chunk index, returns false if any write failed
+bool close_column_writer (Column_writer&);
+
+void write_column (Column_writer&, const std::string& name, int season, int count, const std::function<float (int)>&);
+void write_int_column (Column_writer&, const std::string& name, int season, int count, const std::function<int (int)>&);
+
+// tile latitude, longitude, elevation, water depth and type
+void write_terrain_columns (Column_writer&, const Planet&);
+// tile temperature, humidity and precipitation, and edge wind velocity
+void write_season_columns (Column_writer&, const Planet&, const Season&, int);
+
+void _write_chunk (Column_writer&, const std::string&, uint32_t type, int season, int first, int count, const void*);
+
+#endif
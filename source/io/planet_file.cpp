@@ -0,0 +1,512 @@
+#include "planet_file.h"
+#include "../planet/planet.h"
+#include "season_codec.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PLANET_FILE_MMAP
+#endif
+
+static const char planet_file_magic[8] = {'E', 'A', 'R', 'T', 'H', 'G', 'E', 'N'};
+static const uint32_t planet_file_byte_order = 0x01020304;
+// the largest grid generated, larger sizes in a header would overflow the element counts
+static const int32_t planet_file_max_grid_size = 10;
+
+class Planet_file_writer {
+public:
+	Planet_file_writer (const std::string& name) :
+		out (name.c_str(), std::ios::binary), offset (0) {}
+
+	std::ofstream out;
+	uint64_t offset;
+	std::vector<Planet_file_section> sections;
+};
+
+void _write (Planet_file_writer& w, const void* data, size_t size) {
+	w.out.write(static_cast<const char*>(data), size);
+	w.offset += size;
+}
+
+void _pad (Planet_file_writer& w) {
+	static const char zeros[Planet_file::alignment] = {};
+	size_t padding = (Planet_file::alignment - w.offset % Planet_file::alignment) % Planet_file::alignment;
+	_write(w, zeros, padding);
+}
+
+template <class T>
+void _write_column (Planet_file_writer& w, int column, int season, const std::vector<T>& values) {
+	_pad(w);
+	Planet_file_section s;
+	s.column = column;
+	s.season = season;
+	s.offset = w.offset;
+	s.size = values.size() * sizeof(T);
+	w.sections.push_back(s);
+	_write(w, values.data(), s.size);
+}
+
+// one value per element, taken from f(i)
+template <class T, class F>
+void _write_column (Planet_file_writer& w, int column, int season, int count, F f) {
+	std::vector<T> values(count);
+	for (int i=0; i<count; i++)
+		values[i] = f(i);
+	_write_column(w, column, season, values);
+}
+
+template <class T>
+void _write_ids (Planet_file_writer& w, int column, int count, int width, T ids) {
+	std::vector<int32_t> values(count * width, -1);
+	for (int i=0; i<count; i++)
+		ids(i, &values[i*width]);
+	_write_column(w, column, -1, values);
+}
+
+template <class T>
+void _write_vectors (Planet_file_writer& w, int column, const std::deque<T>& elements) {
+	std::vector<float> values(3*elements.size());
+	for (const T& e : elements) {
+		const Vector3& v = vector(e);
+		values[3*id(e)] = v.x;
+		values[3*id(e)+1] = v.y;
+		values[3*id(e)+2] = v.z;
+	}
+	_write_column(w, column, -1, values);
+}
+
+void _write_grid (Planet_file_writer& w, const Grid& g) {
+	int tiles = g.tiles.size();
+	int corners = g.corners.size();
+	int edges = g.edges.size();
+	_write_vectors(w, Planet_file::tile_vector, g.tiles);
+	_write_ids(w, Planet_file::tile_tiles, tiles, 6, [&](int i, int32_t* ids) {
+		for (int k=0; k<edge_count(g.tiles[i]); k++)
+			ids[k] = id(nth_tile(g.tiles[i], k));
+	});
+	_write_ids(w, Planet_file::tile_corners, tiles, 6, [&](int i, int32_t* ids) {
+		for (int k=0; k<edge_count(g.tiles[i]); k++)
+			ids[k] = id(nth_corner(g.tiles[i], k));
+	});
+	_write_ids(w, Planet_file::tile_edges, tiles, 6, [&](int i, int32_t* ids) {
+		for (int k=0; k<edge_count(g.tiles[i]); k++)
+			ids[k] = id(nth_edge(g.tiles[i], k));
+	});
+	_write_vectors(w, Planet_file::corner_vector, g.corners);
+	_write_ids(w, Planet_file::corner_tiles, corners, 3, [&](int i, int32_t* ids) {
+		for (int k=0; k<3; k++)
+			ids[k] = id(g.corners[i].tiles[k]);
+	});
+	_write_ids(w, Planet_file::corner_corners, corners, 3, [&](int i, int32_t* ids) {
+		for (int k=0; k<3; k++)
+			ids[k] = id(nth_corner(g.corners[i], k));
+	});
+	_write_ids(w, Planet_file::corner_edges, corners, 3, [&](int i, int32_t* ids) {
+		for (int k=0; k<3; k++)
+			ids[k] = id(nth_edge(g.corners[i], k));
+	});
+	_write_ids(w, Planet_file::edge_tiles, edges, 2, [&](int i, int32_t* ids) {
+		for (int k=0; k<2; k++)
+			ids[k] = id(nth_tile(g.edges[i], k));
+	});
+	_write_ids(w, Planet_file::edge_corners, edges, 2, [&](int i, int32_t* ids) {
+		for (int k=0; k<2; k++)
+			ids[k] = id(nth_corner(g.edges[i], k));
+	});
+}
+
+Planet_file_header _header (const Grid& g, int seasons) {
+	Planet_file_header h;
+	std::memset(&h, 0, sizeof(h));
+	std::memcpy(h.magic, planet_file_magic, sizeof(h.magic));
+	h.version = Planet_file::version;
+	h.byte_order = planet_file_byte_order;
+	h.grid_size = g.size;
+	h.tile_count = g.tiles.size();
+	h.corner_count = g.corners.size();
+	h.edge_count = g.edges.size();
+	h.season_count = seasons;
+	return h;
+}
+
+// appends the section table and rewrites the header to point to it
+bool _finish (Planet_file_writer& w, Planet_file_header& h) {
+	_pad(w);
+	h.section_count = w.sections.size();
+	h.sections_offset = w.offset;
+	_write(w, w.sections.data(), w.sections.size() * sizeof(Planet_file_section));
+	w.out.seekp(0);
+	w.out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+	w.out.close();
+	return !w.out.fail();
+}
+
+bool save_planet (const std::string& name, const Planet& p, int keyframe_interval) {
+	Planet_file_writer w(name);
+	if (!w.out)
+		return false;
+
+	Planet_file_header h = _header(*p.grid, climate(p).seasons.size());
+	// header is rewritten once the section table is known
+	_write(w, &h, sizeof(h));
+	_write_grid(w, *p.grid);
+
+	const Terrain& t = terrain(p);
+	std::vector<double> variables = {t.var.axis.x, t.var.axis.y, t.var.axis.z, t.var.axial_tilt, t.var.radius, t.var.sea_level};
+	_write_column(w, Planet_file::terrain_variables, -1, variables);
+	_write_column<float>(w, Planet_file::tile_elevation, -1, h.tile_count, [&](int i) {return nth_tile(t, i).elevation;});
+	_write_column<float>(w, Planet_file::tile_water_surface, -1, h.tile_count, [&](int i) {return nth_tile(t, i).water.surface;});
+	_write_column<float>(w, Planet_file::tile_water_depth, -1, h.tile_count, [&](int i) {return nth_tile(t, i).water.depth;});
+	_write_column<int32_t>(w, Planet_file::tile_type, -1, h.tile_count, [&](int i) {return nth_tile(t, i).type;});
+	_write_column<float>(w, Planet_file::corner_elevation, -1, h.corner_count, [&](int i) {return nth_corner(t, i).elevation;});
+	_write_column<int32_t>(w, Planet_file::corner_river_direction, -1, h.corner_count, [&](int i) {return nth_corner(t, i).river_direction;});
+	_write_column<int32_t>(w, Planet_file::corner_distance_to_sea, -1, h.corner_count, [&](int i) {return nth_corner(t, i).distance_to_sea;});
+	_write_column<int32_t>(w, Planet_file::corner_type, -1, h.corner_count, [&](int i) {return nth_corner(t, i).type;});
+	_write_column<int32_t>(w, Planet_file::edge_type, -1, h.edge_count, [&](int i) {return nth_edge(t, i).type;});
+
+	// seasons are stored one after another, so loading one only reads its own pages
+	std::vector<int32_t> keyframe;
+	for (int n=0; keyframe_interval > 0 && n<h.season_count; n++) {
+		std::vector<unsigned char> encoded;
+		int reference = n - n % keyframe_interval;
+		if (n == reference) {
+			encode_season(encoded, nth_season(p, n), n, reference, nullptr);
+			quantize_season(nth_season(p, n), keyframe);
+		}
+		else
+			encode_season(encoded, nth_season(p, n), n, reference, &keyframe);
+		_write_column(w, Planet_file::season_encoded, n, encoded);
+	}
+	for (int n=0; keyframe_interval == 0 && n<h.season_count; n++) {
+		const Season& s = nth_season(p, n);
+		_write_column<float>(w, Planet_file::tile_temperature, n, h.tile_count, [&](int i) {return nth_tile(s, i).temperature;});
+		_write_column<float>(w, Planet_file::tile_humidity, n, h.tile_count, [&](int i) {return nth_tile(s, i).humidity;});
+		_write_column<float>(w, Planet_file::tile_precipitation, n, h.tile_count, [&](int i) {return nth_tile(s, i).precipitation;});
+		_write_column<float>(w, Planet_file::tile_wind_direction, n, h.tile_count, [&](int i) {return nth_tile(s, i).wind.direction;});
+		_write_column<float>(w, Planet_file::tile_wind_speed, n, h.tile_count, [&](int i) {return nth_tile(s, i).wind.speed;});
+		_write_column<float>(w, Planet_file::corner_river_flow_increase, n, h.corner_count, [&](int i) {return nth_corner(s, i).river_flow_increase;});
+		_write_column<float>(w, Planet_file::edge_wind_velocity, n, h.edge_count, [&](int i) {return nth_edge(s, i).wind_velocity;});
+		_write_column<float>(w, Planet_file::edge_river_flow, n, h.edge_count, [&](int i) {return nth_edge(s, i).river_flow;});
+	}
+
+	return _finish(w, h);
+}
+
+bool save_grid (const std::string& name, const Grid& g) {
+	Planet_file_writer w(name);
+	if (!w.out)
+		return false;
+	Planet_file_header h = _header(g, 0);
+	_write(w, &h, sizeof(h));
+	_write_grid(w, g);
+	return _finish(w, h);
+}
+
+Planet_file::~Planet_file () {
+	close_planet_file(*this);
+}
+
+bool _map_file (Planet_file& f, const std::string& name) {
+#ifdef PLANET_FILE_MMAP
+	int fd = open(name.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	void* data = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size > 0)
+		data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data != MAP_FAILED) {
+		f.data = static_cast<const char*>(data);
+		f.size = st.st_size;
+		f.mapped = true;
+		return true;
+	}
+#endif
+	std::ifstream in(name.c_str(), std::ios::binary | std::ios::ate);
+	if (!in)
+		return false;
+	f.buffer.resize(in.tellg());
+	in.seekg(0);
+	in.read(f.buffer.data(), f.buffer.size());
+	if (!in)
+		return false;
+	f.data = f.buffer.data();
+	f.size = f.buffer.size();
+	return true;
+}
+
+bool open_planet_file (Planet_file& f, const std::string& name) {
+	close_planet_file(f);
+	if (!_map_file(f, name))
+		return false;
+	const Planet_file_header* h = reinterpret_cast<const Planet_file_header*>(f.data);
+	bool valid =
+		f.size >= sizeof(Planet_file_header) &&
+		std::memcmp(h->magic, planet_file_magic, sizeof(h->magic)) == 0 &&
+		h->version >= 1 && h->version <= Planet_file::version &&
+		h->byte_order == planet_file_byte_order &&
+		h->grid_size >= 0 && h->grid_size <= planet_file_max_grid_size &&
+		h->tile_count == tile_count(h->grid_size) &&
+		h->corner_count == corner_count(h->grid_size) &&
+		h->edge_count == edge_count(h->grid_size) &&
+		h->sections_offset <= f.size &&
+		h->section_count <= (f.size - h->sections_offset) / sizeof(Planet_file_section);
+	if (valid) {
+		f.header = h;
+		f.sections = reinterpret_cast<const Planet_file_section*>(f.data + h->sections_offset);
+		for (uint32_t i=0; i<h->section_count && valid; i++)
+			valid = f.sections[i].offset % Planet_file::alignment == 0 &&
+				f.sections[i].offset <= f.size && f.sections[i].size <= f.size - f.sections[i].offset;
+	}
+	if (!valid)
+		close_planet_file(f);
+	return valid;
+}
+
+void close_planet_file (Planet_file& f) {
+#ifdef PLANET_FILE_MMAP
+	if (f.mapped)
+		munmap(const_cast<char*>(f.data), f.size);
+#endif
+	std::vector<char>().swap(f.buffer);
+	f.data = nullptr;
+	f.size = 0;
+	f.mapped = false;
+	f.header = nullptr;
+	f.sections = nullptr;
+	f.decoder = Season_decoder();
+}
+
+const void* column_data (const Planet_file& f, int column, int season) {
+	if (!f.header)
+		return nullptr;
+	for (uint32_t i=0; i<f.header->section_count; i++) {
+		const Planet_file_section& s = f.sections[i];
+		if ((int)s.column == column && s.season == season)
+			return f.data + s.offset;
+	}
+	return nullptr;
+}
+
+// column with room for count values, nullptr if missing or short
+template <class T>
+const T* _column (const Planet_file& f, int column, int season, int count) {
+	for (uint32_t i=0; i<f.header->section_count; i++) {
+		const Planet_file_section& s = f.sections[i];
+		if ((int)s.column == column && s.season == season)
+			return s.size >= count * sizeof(T) ? reinterpret_cast<const T*>(f.data + s.offset) : nullptr;
+	}
+	return nullptr;
+}
+
+bool _valid_ids (const int32_t* ids, int count, int limit) {
+	for (int i=0; i<count; i++)
+		if (ids[i] < 0 || ids[i] >= limit)
+			return false;
+	return true;
+}
+
+Grid* load_grid (const Planet_file& f) {
+	if (!f.header)
+		return nullptr;
+	const Planet_file_header& h = *f.header;
+	const float* tile_vectors = _column<float>(f, Planet_file::tile_vector, -1, 3*h.tile_count);
+	const int32_t* tile_tiles = _column<int32_t>(f, Planet_file::tile_tiles, -1, 6*h.tile_count);
+	const int32_t* tile_corners = _column<int32_t>(f, Planet_file::tile_corners, -1, 6*h.tile_count);
+	const int32_t* tile_edges = _column<int32_t>(f, Planet_file::tile_edges, -1, 6*h.tile_count);
+	const float* corner_vectors = _column<float>(f, Planet_file::corner_vector, -1, 3*h.corner_count);
+	const int32_t* corner_tiles = _column<int32_t>(f, Planet_file::corner_tiles, -1, 3*h.corner_count);
+	const int32_t* corner_corners = _column<int32_t>(f, Planet_file::corner_corners, -1, 3*h.corner_count);
+	const int32_t* corner_edges = _column<int32_t>(f, Planet_file::corner_edges, -1, 3*h.corner_count);
+	const int32_t* edge_tiles = _column<int32_t>(f, Planet_file::edge_tiles, -1, 2*h.edge_count);
+	const int32_t* edge_corners = _column<int32_t>(f, Planet_file::edge_corners, -1, 2*h.edge_count);
+	if (!tile_vectors || !tile_tiles || !tile_corners || !tile_edges ||
+		!corner_vectors || !corner_tiles || !corner_corners || !corner_edges ||
+		!edge_tiles || !edge_corners)
+		return nullptr;
+
+	Grid* g = new Grid(h.grid_size);
+	bool valid = true;
+	for (Tile& t : g->tiles) {
+		int i = t.id;
+		t.v = Vector3(tile_vectors[3*i], tile_vectors[3*i+1], tile_vectors[3*i+2]);
+		valid = valid &&
+			_valid_ids(tile_tiles + 6*i, t.edge_count, h.tile_count) &&
+			_valid_ids(tile_corners + 6*i, t.edge_count, h.corner_count) &&
+			_valid_ids(tile_edges + 6*i, t.edge_count, h.edge_count);
+		if (!valid)
+			break;
+		for (int k=0; k<t.edge_count; k++) {
+			t.tiles[k] = &g->tiles[tile_tiles[6*i+k]];
+			t.corners[k] = &g->corners[tile_corners[6*i+k]];
+			t.edges[k] = &g->edges[tile_edges[6*i+k]];
+		}
+	}
+	for (Corner& c : g->corners) {
+		int i = c.id;
+		c.v = Vector3(corner_vectors[3*i], corner_vectors[3*i+1], corner_vectors[3*i+2]);
+		valid = valid &&
+			_valid_ids(corner_tiles + 3*i, 3, h.tile_count) &&
+			_valid_ids(corner_corners + 3*i, 3, h.corner_count) &&
+			_valid_ids(corner_edges + 3*i, 3, h.edge_count);
+		if (!valid)
+			break;
+		for (int k=0; k<3; k++) {
+			c.tiles[k] = &g->tiles[corner_tiles[3*i+k]];
+			c.corners[k] = &g->corners[corner_corners[3*i+k]];
+			c.edges[k] = &g->edges[corner_edges[3*i+k]];
+		}
+	}
+	for (Edge& e : g->edges) {
+		int i = e.id;
+		valid = valid &&
+			_valid_ids(edge_tiles + 2*i, 2, h.tile_count) &&
+			_valid_ids(edge_corners + 2*i, 2, h.corner_count);
+		if (!valid)
+			break;
+		for (int k=0; k<2; k++) {
+			e.tiles[k] = &g->tiles[edge_tiles[2*i+k]];
+			e.corners[k] = &g->corners[edge_corners[2*i+k]];
+		}
+	}
+	if (!valid) {
+		delete g;
+		return nullptr;
+	}
+	return g;
+}
+
+bool load_planet (Planet& p, const Planet_file& f) {
+	if (!f.header)
+		return false;
+	const Planet_file_header& h = *f.header;
+	const double* variables = _column<double>(f, Planet_file::terrain_variables, -1, 6);
+	const float* tile_elevation = _column<float>(f, Planet_file::tile_elevation, -1, h.tile_count);
+	const float* tile_water_surface = _column<float>(f, Planet_file::tile_water_surface, -1, h.tile_count);
+	const float* tile_water_depth = _column<float>(f, Planet_file::tile_water_depth, -1, h.tile_count);
+	const int32_t* tile_type = _column<int32_t>(f, Planet_file::tile_type, -1, h.tile_count);
+	const float* corner_elevation = _column<float>(f, Planet_file::corner_elevation, -1, h.corner_count);
+	const int32_t* corner_river_direction = _column<int32_t>(f, Planet_file::corner_river_direction, -1, h.corner_count);
+	const int32_t* corner_distance_to_sea = _column<int32_t>(f, Planet_file::corner_distance_to_sea, -1, h.corner_count);
+	const int32_t* corner_type = _column<int32_t>(f, Planet_file::corner_type, -1, h.corner_count);
+	const int32_t* edge_type = _column<int32_t>(f, Planet_file::edge_type, -1, h.edge_count);
+	if (!variables || !tile_elevation || !tile_water_surface || !tile_water_depth || !tile_type ||
+		!corner_elevation || !corner_river_direction || !corner_distance_to_sea || !corner_type || !edge_type)
+		return false;
+	Grid* g = load_grid(f);
+	if (!g)
+		return false;
+
+	clear_climate(p);
+	p.grid.reset(g);
+	init_terrain(p);
+	Terrain& t = m_terrain(p);
+	t.var.axis = Vector3(variables[0], variables[1], variables[2]);
+	t.var.axial_tilt = variables[3];
+	t.var.radius = variables[4];
+	t.var.sea_level = variables[5];
+	for (int i=0; i<h.tile_count; i++) {
+		Terrain_tile& tile = m_tile(t, i);
+		tile.elevation = tile_elevation[i];
+		tile.water.surface = tile_water_surface[i];
+		tile.water.depth = tile_water_depth[i];
+		tile.type = tile_type[i];
+	}
+	for (int i=0; i<h.corner_count; i++) {
+		Terrain_corner& corner = m_corner(t, i);
+		corner.elevation = corner_elevation[i];
+		corner.river_direction = corner_river_direction[i];
+		corner.distance_to_sea = corner_distance_to_sea[i];
+		corner.type = corner_type[i];
+	}
+	for (int i=0; i<h.edge_count; i++)
+		m_edge(t, i).type = edge_type[i];
+
+	m_climate(p).var.season_count = h.season_count;
+	m_climate(p).seasons.resize(h.season_count);
+	return true;
+}
+
+const Planet_file_section* _section (const Planet_file& f, int column, int season) {
+	for (uint32_t i=0; i<f.header->section_count; i++)
+		if ((int)f.sections[i].column == column && f.sections[i].season == season)
+			return &f.sections[i];
+	return nullptr;
+}
+
+bool _load_encoded_season (Season& s, Planet_file& f, const Planet_file_section& section) {
+	const unsigned char* data = reinterpret_cast<const unsigned char*>(f.data + section.offset);
+	int reference = season_reference(data, section.size);
+	const Planet_file_section* key = reference >= 0 ? _section(f, Planet_file::season_encoded, reference) : nullptr;
+	if (!key)
+		return false;
+	const unsigned char* key_data = reinterpret_cast<const unsigned char*>(f.data + key->offset);
+	Season decoded;
+	if (!decode_season(f.decoder, data, section.size, key_data, key->size,
+		f.header->tile_count, f.header->corner_count, f.header->edge_count, decoded))
+		return false;
+	std::swap(s, decoded);
+	return true;
+}
+
+bool load_season (Planet& p, Planet_file& f, int n) {
+	if (!f.header || n < 0 || n >= f.header->season_count || n >= (int)climate(p).seasons.size())
+		return false;
+	if (season_loaded(p, n))
+		return true;
+	const Planet_file_section* encoded = _section(f, Planet_file::season_encoded, n);
+	if (encoded)
+		return _load_encoded_season(m_season(p, n), f, *encoded);
+	const Planet_file_header& h = *f.header;
+	const float* temperature = _column<float>(f, Planet_file::tile_temperature, n, h.tile_count);
+	const float* humidity = _column<float>(f, Planet_file::tile_humidity, n, h.tile_count);
+	const float* precipitation = _column<float>(f, Planet_file::tile_precipitation, n, h.tile_count);
+	const float* wind_direction = _column<float>(f, Planet_file::tile_wind_direction, n, h.tile_count);
+	const float* wind_speed = _column<float>(f, Planet_file::tile_wind_speed, n, h.tile_count);
+	const float* river_flow_increase = _column<float>(f, Planet_file::corner_river_flow_increase, n, h.corner_count);
+	const float* wind_velocity = _column<float>(f, Planet_file::edge_wind_velocity, n, h.edge_count);
+	const float* river_flow = _column<float>(f, Planet_file::edge_river_flow, n, h.edge_count);
+	if (!temperature || !humidity || !precipitation || !wind_direction || !wind_speed ||
+		!river_flow_increase || !wind_velocity || !river_flow)
+		return false;
+
+	Season& s = m_season(p, n);
+	s.tiles.resize(h.tile_count);
+	s.corners.resize(h.corner_count);
+	s.edges.resize(h.edge_count);
+	for (int i=0; i<h.tile_count; i++) {
+		Climate_tile& t = m_tile(s, i);
+		t.temperature = temperature[i];
+		t.humidity = humidity[i];
+		t.precipitation = precipitation[i];
+		t.wind.direction = wind_direction[i];
+		t.wind.speed = wind_speed[i];
+	}
+	for (int i=0; i<h.corner_count; i++)
+		m_corner(s, i).river_flow_increase = river_flow_increase[i];
+	for (int i=0; i<h.edge_count; i++) {
+		Climate_edge& e = m_edge(s, i);
+		e.wind_velocity = wind_velocity[i];
+		e.river_flow = river_flow[i];
+	}
+	return true;
+}
+
+bool season_loaded (const Planet& p, int n) {
+	return !nth_season(p, n).tiles.empty();
+}
+
+bool load_planet (Planet& p, const std::string& name) {
+	Planet_file f;
+	if (!open_planet_file(f, name) || !load_planet(p, f))
+		return false;
+	for (int i=0; i<season_count(p); i++)
+		if (!load_season(p, f, i))
+			return false;
+	return true;
+}
@@ -0,0 +1,105 @@
+#ifndef planet_file_h
+#define planet_file_h
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "season_codec.h"
+class Planet;
+class Grid;
+
+// fixed size header at the start of a planet file, all values in native byte order
+class Planet_file_header {
+public:
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	int32_t grid_size;
+	int32_t tile_count;
+	int32_t corner_count;
+	int32_t edge_count;
+	int32_t season_count;
+	uint32_t section_count;
+	uint64_t sections_offset;
+	char reserved[16];
+};
+
+// location of one column, season is -1 for columns outside the climate
+class Planet_file_section {
+public:
+	uint32_t column;
+	int32_t season;
+	uint64_t offset;
+	uint64_t size;
+};
+
+// a planet file mapped into memory, columns are read in place and
+// pages of a season are only touched when that season is loaded
+class Planet_file {
+public:
+	Planet_file () :
+		data (nullptr), size (0), mapped (false), header (nullptr), sections (nullptr) {}
+	~Planet_file ();
+	Planet_file (const Planet_file&) = delete;
+	Planet_file& operator = (const Planet_file&) = delete;
+
+	const char* data;
+	size_t size;
+	bool mapped;
+	// file contents when memory mapping is unavailable
+	std::vector<char> buffer;
+	const Planet_file_header* header;
+	const Planet_file_section* sections;
+	// keeps the last keyframe of compressed seasons
+	Season_decoder decoder;
+
+	// 2 added compressed seasons
+	static const uint32_t version = 2;
+	// columns are padded to this alignment in the file
+	static const int alignment = 64;
+
+	enum {
+		// grid, vectors are 3 floats and neighbours are ids, -1 where a pentagon has no sixth
+		tile_vector = 1, tile_tiles, tile_corners, tile_edges,
+		corner_vector, corner_tiles, corner_corners, corner_edges,
+		edge_tiles, edge_corners,
+		// terrain, variables are axis x, y, z, axial tilt, radius and sea level as doubles
+		terrain_variables = 32,
+		tile_elevation, tile_water_surface, tile_water_depth, tile_type,
+		corner_elevation, corner_river_direction, corner_distance_to_sea, corner_type,
+		edge_type,
+		// one of each per season
+		tile_temperature = 64, tile_humidity, tile_precipitation, tile_wind_direction, tile_wind_speed,
+		corner_river_flow_increase,
+		edge_wind_velocity, edge_river_flow,
+		// replaces the season columns above in files with compressed seasons
+		season_encoded = 96
+	};
+};
+
+// seasons are stored compressed, see season_codec.h, with a keyframe_interval above 0
+bool save_planet (const std::string&, const Planet&, int keyframe_interval = 0);
+// grid columns only, as used by the grid cache
+bool save_grid (const std::string&, const Grid&);
+
+// maps the file and checks its header and section table
+bool open_planet_file (Planet_file&, const std::string&);
+void close_planet_file (Planet_file&);
+// start of a column, nullptr if the file has none
+const void* column_data (const Planet_file&, int column, int season = -1);
+template <class T>
+const T* column (const Planet_file& f, int c, int season = -1) {
+	return static_cast<const T*>(column_data(f, c, season));
+}
+
+// new grid built from the grid columns, nullptr if they are missing or inconsistent
+Grid* load_grid (const Planet_file&);
+// replaces grid and terrain, and creates empty seasons to be filled by load_season
+bool load_planet (Planet&, const Planet_file&);
+bool load_season (Planet&, Planet_file&, int);
+bool season_loaded (const Planet&, int);
+// opens the file and loads every season
+bool load_planet (Planet&, const std::string&);
+
+#endif
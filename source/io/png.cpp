@@ -0,0 +1,180 @@
+#include "png.h"
+#include "../render/image.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+std::vector<unsigned long> _crc_table () {
+	std::vector<unsigned long> table(256);
+	for (unsigned long n=0; n<256; n++) {
+		unsigned long c = n;
+		for (int k=0; k<8; k++)
+			c = c & 1 ? 0xedb88320L ^ (c >> 1) : c >> 1;
+		table[n] = c;
+	}
+	return table;
+}
+
+unsigned long png_crc (unsigned long crc, const unsigned char* data, size_t length) {
+	static const std::vector<unsigned long> table = _crc_table();
+	crc ^= 0xffffffffL;
+	for (size_t i=0; i<length; i++)
+		crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+	return crc ^ 0xffffffffL;
+}
+
+unsigned long png_adler (unsigned long adler, const unsigned char* data, size_t length) {
+	unsigned long a = adler & 0xffff;
+	unsigned long b = (adler >> 16) & 0xffff;
+	while (length > 0) {
+		// largest block before b can overflow 32 bits
+		size_t block = std::min(length, (size_t)5552);
+		length -= block;
+		while (block--) {
+			a += *data++;
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+	}
+	return (b << 16) | a;
+}
+
+class Png_writer {
+public:
+	Png_writer (FILE* f) :
+		file (f), bits (0), bit_count (0), adler (1) {}
+
+	FILE* file;
+	std::vector<unsigned char> data;
+	unsigned long bits;
+	int bit_count;
+	unsigned long adler;
+};
+
+void _write_u32 (std::vector<unsigned char>& v, unsigned long n) {
+	v.push_back((n >> 24) & 0xff);
+	v.push_back((n >> 16) & 0xff);
+	v.push_back((n >> 8) & 0xff);
+	v.push_back(n & 0xff);
+}
+
+void _write_chunk (FILE* f, const char* type, const std::vector<unsigned char>& content) {
+	std::vector<unsigned char> v;
+	_write_u32(v, content.size());
+	v.insert(v.end(), type, type+4);
+	v.insert(v.end(), content.begin(), content.end());
+	_write_u32(v, png_crc(0, &v[4], v.size()-4));
+	fwrite(&v[0], 1, v.size(), f);
+}
+
+void _flush_data (Png_writer& w) {
+	if (w.data.size() > 0)
+		_write_chunk(w.file, "IDAT", w.data);
+	w.data.clear();
+}
+
+// deflate stores bits least significant first
+void _put_bits (Png_writer& w, unsigned long value, int count) {
+	w.bits |= value << w.bit_count;
+	w.bit_count += count;
+	while (w.bit_count >= 8) {
+		w.data.push_back(w.bits & 0xff);
+		w.bits >>= 8;
+		w.bit_count -= 8;
+	}
+	if (w.data.size() >= 1 << 20)
+		_flush_data(w);
+}
+
+// huffman codes are stored most significant bit first
+void _put_code (Png_writer& w, unsigned long code, int length) {
+	unsigned long reversed = 0;
+	for (int i=0; i<length; i++)
+		reversed |= ((code >> i) & 1) << (length-1-i);
+	_put_bits(w, reversed, length);
+}
+
+void _put_symbol (Png_writer& w, int symbol) {
+	if (symbol < 144)
+		_put_code(w, 0x30 + symbol, 8);
+	else if (symbol < 256)
+		_put_code(w, 0x190 + symbol - 144, 9);
+	else if (symbol < 280)
+		_put_code(w, symbol - 256, 7);
+	else
+		_put_code(w, 0xc0 + symbol - 280, 8);
+}
+
+void _put_length (Png_writer& w, int length) {
+	static const int base[29] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+	static const int extra[29] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+	int i = 28;
+	while (base[i] > length)
+		i--;
+	_put_symbol(w, 257 + i);
+	_put_bits(w, length - base[i], extra[i]);
+}
+
+void _put_row (Png_writer& w, const unsigned char* row, int length) {
+	// filter type none
+	_put_symbol(w, 0);
+	w.adler = png_adler(w.adler, (const unsigned char*)"\0", 1);
+	w.adler = png_adler(w.adler, row, length);
+	int i = 0;
+	while (i < length) {
+		// only matches against the previous pixel, which covers the flat areas of a map
+		int run = 0;
+		if (i >= 3)
+			while (i+run < length && run < 258 && row[i+run] == row[i+run-3])
+				run++;
+		if (run >= 3) {
+			_put_length(w, run);
+			// distance code 2 is a distance of 3 bytes, with no extra bits
+			_put_code(w, 2, 5);
+			i += run;
+		}
+		else {
+			_put_symbol(w, row[i]);
+			i++;
+		}
+	}
+}
+
+bool write_png (const std::string& filename, const Image& image) {
+	FILE* f = fopen(filename.c_str(), "wb");
+	if (f == nullptr)
+		return false;
+	static const unsigned char signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+	fwrite(signature, 1, 8, f);
+
+	std::vector<unsigned char> header;
+	_write_u32(header, image.width);
+	_write_u32(header, image.height);
+	// 8 bit rgb, no interlacing
+	unsigned char rest[5] = {8, 2, 0, 0, 0};
+	header.insert(header.end(), rest, rest+5);
+	_write_chunk(f, "IHDR", header);
+
+	Png_writer w(f);
+	// zlib header, then a single final block with fixed codes
+	w.data.push_back(0x78);
+	w.data.push_back(0x01);
+	_put_bits(w, 1, 1);
+	_put_bits(w, 1, 2);
+	for (int i=0; i<image.height; i++)
+		_put_row(w, row(image, i), 3*image.width);
+	_put_symbol(w, 256);
+	if (w.bit_count > 0)
+		_put_bits(w, 0, 8 - w.bit_count);
+	_write_u32(w.data, w.adler);
+	_flush_data(w);
+
+	_write_chunk(f, "IEND", std::vector<unsigned char>());
+	bool ok = !ferror(f);
+	return fclose(f) == 0 && ok;
+}
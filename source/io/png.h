@@ -0,0 +1,16 @@
+#ifndef png_h
+#define png_h
+
+#include <string>
+#include <cstddef>
+class Image;
+
+// writes an rgb png, compressed with fixed huffman codes and runs of repeated pixels,
+// returns false if the file could not be written
+bool write_png (const std::string& filename, const Image&);
+
+// checksums used by the png and zlib containers
+unsigned long png_crc (unsigned long crc, const unsigned char*, size_t);
+unsigned long png_adler (unsigned long adler, const unsigned char*, size_t);
+
+#endif
@@ -0,0 +1,168 @@
+#include "raster_export.h"
+#include "../planet/planet.h"
+#include "../planet/grid/tile_locator.h"
+#include "../math/quaternion.h"
+#include "../math/math_common.h"
+#include "../thread/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+
+void elevation_field (Raster_field& f, const Planet& p) {
+	f.tiles.resize(tile_count(p));
+	f.corners.resize(corner_count(p));
+	for (int i=0; i<tile_count(p); i++)
+		f.tiles[i] = elevation(nth_tile(terrain(p), i));
+	for (int i=0; i<corner_count(p); i++)
+		f.corners[i] = elevation(nth_corner(terrain(p), i));
+}
+
+bool season_field (Raster_field& f, const Planet& p, const Season& s, const std::string& name) {
+	float (*value)(const Climate_tile&) = nullptr;
+	if (name == "temperature") value = temperature;
+	else if (name == "humidity") value = humidity;
+	else if (name == "precipitation") value = precipitation;
+	if (!value)
+		return false;
+	f.tiles.resize(tile_count(p));
+	f.corners.resize(corner_count(p));
+	for (int i=0; i<tile_count(p); i++)
+		f.tiles[i] = value(nth_tile(s, i));
+	for (int i=0; i<corner_count(p); i++) {
+		float sum = 0;
+		for (const Tile* t : tiles(nth_corner(p, i)))
+			sum += f.tiles[id(t)];
+		f.corners[i] = sum / 3;
+	}
+	return true;
+}
+
+float sample_field (const Raster_field& f, const Tile* t, const Vector3& v) {
+	Raster_triangle triangle;
+	float value = f.tiles[id(t)];
+	if (find_triangle(triangle, f, t, v))
+		interpolate(triangle, v, value);
+	return value;
+}
+
+bool find_triangle (Raster_triangle& r, const Raster_field& f, const Tile* t, const Vector3& v) {
+	const Vector3& c = vector(t);
+	for (int k=0; k<edge_count(t); k++) {
+		const Corner* a = nth_corner(t, k);
+		const Corner* b = nth_corner(t, k+1);
+		r.tile = t;
+		r.sides[0] = cross_product(vector(a), vector(b));
+		r.sides[1] = cross_product(vector(b), c);
+		r.sides[2] = cross_product(c, vector(a));
+		r.values[0] = f.tiles[id(t)];
+		r.values[1] = f.corners[id(a)];
+		r.values[2] = f.corners[id(b)];
+		float value;
+		if (interpolate(r, v, value))
+			return true;
+	}
+	r.tile = nullptr;
+	return false;
+}
+
+bool interpolate (const Raster_triangle& r, const Vector3& v, float& value) {
+	// barycentric coordinates of the ray through v, unnormalized
+	double w0 = dot_product(v, r.sides[0]);
+	double w1 = dot_product(v, r.sides[1]);
+	double w2 = dot_product(v, r.sides[2]);
+	if (!((w0 >= 0 && w1 >= 0 && w2 >= 0) || (w0 <= 0 && w1 <= 0 && w2 <= 0)))
+		return false;
+	double sum = w0 + w1 + w2;
+	value = sum == 0 ? r.values[0] : (w0*r.values[0] + w1*r.values[1] + w2*r.values[2]) / sum;
+	return true;
+}
+
+int raster_width (const Raster_export& e) {
+	return std::max(1, e.width);
+}
+
+int raster_height (const Raster_export& e) {
+	if (e.projection == Raster_export::cube_map)
+		return 6 * raster_width(e);
+	return std::max(1, raster_width(e) / 2);
+}
+
+Vector3 cube_map_direction (int face, int x, int y, int size) {
+	double s = 2.0 * (x + 0.5) / size - 1.0;
+	double t = 2.0 * (y + 0.5) / size - 1.0;
+	switch (face) {
+		case 0: return normal(Vector3(1, -t, -s));
+		case 1: return normal(Vector3(-1, -t, s));
+		case 2: return normal(Vector3(s, 1, t));
+		case 3: return normal(Vector3(s, -1, -t));
+		case 4: return normal(Vector3(s, -t, 1));
+		default: return normal(Vector3(-s, -t, -1));
+	}
+}
+
+void _sample_row (float* row, const Raster_export& e, const Planet& p, const Raster_field& f, const Tile_locator& locator, const Vector3 (&axes)[3], const std::vector<double>& cos_longitude, const std::vector<double>& sin_longitude, int y) {
+	int width = raster_width(e);
+	double cos_latitude = 0, sin_latitude = 0;
+	if (e.projection == Raster_export::equirectangular) {
+		double latitude = pi/2 - (y + 0.5) * pi / raster_height(e);
+		cos_latitude = std::cos(latitude);
+		sin_latitude = std::sin(latitude);
+	}
+	const Tile* t = nullptr;
+	Raster_triangle triangle;
+	for (int x=0; x<width; x++) {
+		Vector3 d;
+		if (e.projection == Raster_export::equirectangular)
+			d = Vector3(cos_latitude * cos_longitude[x], cos_latitude * sin_longitude[x], sin_latitude);
+		else
+			d = cube_map_direction(y / width, x, y % width, width);
+		Vector3 v = axes[0]*d.x + axes[1]*d.y + axes[2]*d.z;
+		// most pixels fall in the triangle of the previous one, the rest are in the same or an
+		// adjacent tile, so only the first pixel of a row is located from scratch
+		if (triangle.tile && interpolate(triangle, v, row[x]))
+			continue;
+		t = t ? find_tile(p, v, t) : find_tile(locator, p, v);
+		if (!find_triangle(triangle, f, t, v) || !interpolate(triangle, v, row[x]))
+			row[x] = f.tiles[id(t)];
+	}
+}
+
+bool export_raster (const std::string& name, const Raster_export& e, const Planet& p, const Raster_field& f) {
+	std::ofstream out(name.c_str(), std::ios::binary);
+	if (!out)
+		return false;
+	int width = raster_width(e);
+	int height = raster_height(e);
+	const uint16_t byte_order = 1;
+	bool little_endian = *reinterpret_cast<const unsigned char*>(&byte_order) == 1;
+	out << "Pf\n" << width << " " << height << "\n" << (little_endian ? "-1.0" : "1.0") << "\n";
+
+	Tile_locator locator;
+	init_locator(locator, p);
+	// axes of the planet's default frame, where z points north and x is at longitude 0
+	Quaternion to_planet = conjugate(rotation_to_default(p));
+	const Vector3 axes[3] = {to_planet * Vector3(1,0,0), to_planet * Vector3(0,1,0), to_planet * Vector3(0,0,1)};
+	std::vector<double> cos_longitude, sin_longitude;
+	if (e.projection == Raster_export::equirectangular) {
+		for (int x=0; x<width; x++) {
+			double longitude = -pi + (x + 0.5) * 2*pi / width;
+			cos_longitude.push_back(std::cos(longitude));
+			sin_longitude.push_back(std::sin(longitude));
+		}
+	}
+
+	int strip_rows = std::max(1, e.strip_rows);
+	std::vector<float> strip;
+	for (int bottom = height; bottom > 0 && out; bottom -= strip_rows) {
+		int top = std::max(0, bottom - strip_rows);
+		strip.resize((size_t)(bottom - top) * width);
+		parallel_for(top, bottom, 1, [&](int first, int last) {
+			for (int y=first; y<last; y++)
+				_sample_row(&strip[(size_t)(bottom - 1 - y) * width], e, p, f, locator, axes, cos_longitude, sin_longitude, y);
+		});
+		out.write(reinterpret_cast<const char*>(strip.data()), strip.size() * sizeof(float));
+	}
+	out.close();
+	return !out.fail();
+}
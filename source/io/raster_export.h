@@ -0,0 +1,69 @@
+#ifndef raster_export_h
+#define raster_export_h
+
+#include <string>
+#include <vector>
+#include "../math/vector3.h"
+class Planet;
+class Season;
+class Tile;
+
+// one quantity per tile and per corner, corners of climate quantities hold the mean of their tiles
+class Raster_field {
+public:
+	Raster_field () {}
+
+	std::vector<float> tiles;
+	std::vector<float> corners;
+};
+
+void elevation_field (Raster_field&, const Planet&);
+// temperature, humidity or precipitation, false for other names
+bool season_field (Raster_field&, const Planet&, const Season&, const std::string&);
+
+// one triangle of a tile between its centre and two neighbouring corners,
+// kept while sampling so points in the same triangle skip the tile lookup
+class Raster_triangle {
+public:
+	Raster_triangle () :
+		tile (nullptr) {}
+
+	const Tile* tile;
+	// normals of the planes through the planet's centre and the side opposite each vertex
+	Vector3 sides[3];
+	// values at the centre and the two corners
+	float values[3];
+};
+
+// value at a point inside the tile, interpolated between the tile centre and the two
+// corners of the triangle of the tile containing the point
+float sample_field (const Raster_field&, const Tile*, const Vector3&);
+// the triangle of the tile containing the point, false if none does
+bool find_triangle (Raster_triangle&, const Raster_field&, const Tile*, const Vector3&);
+// the interpolated value at a point, false if the point is outside the triangle
+bool interpolate (const Raster_triangle&, const Vector3&, float&);
+
+// rasters are written as portable float maps (.pfm) in native byte order, bottom row first,
+// a strip of rows at a time so memory use is independent of the height
+class Raster_export {
+public:
+	Raster_export () :
+		projection (equirectangular), width (4096), strip_rows (256) {}
+
+	int projection;
+	// equirectangular rasters are width by width/2, cube maps are six width by width faces
+	// stacked top to bottom in the order +x, -x, +y, -y, +z, -z
+	int width;
+	int strip_rows;
+
+	enum {equirectangular, cube_map};
+};
+
+int raster_width (const Raster_export&);
+int raster_height (const Raster_export&);
+bool export_raster (const std::string&, const Raster_export&, const Planet&, const Raster_field&);
+
+// direction of the centre of a cube map pixel in the planet's default frame, x and y within the face
+Vector3 cube_map_direction (int face, int x, int y, int size);
+
+#endif
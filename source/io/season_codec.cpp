@@ -0,0 +1,391 @@
+#include "season_codec.h"
+#include "../planet/planet.h"
+#include "../thread/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+
+// tile temperature, humidity, precipitation, wind direction and wind speed,
+// corner river flow increase, edge wind velocity and river flow
+static const int field_count = 8;
+static const int field_mantissa_bits[field_count] = {16, 12, 12, 12, 12, 12, 12, 12};
+
+static const int rans_bits = 12;
+static const uint32_t rans_scale = 1u << rans_bits;
+static const uint32_t rans_low = 1u << 23;
+
+class Season_codec_header {
+public:
+	uint32_t index;
+	uint32_t reference;
+	uint32_t tile_count;
+	uint32_t corner_count;
+	uint32_t edge_count;
+};
+
+// each field is coded as its own stream, so fields are encoded and decoded in parallel
+class Season_codec_stream {
+public:
+	// from the start of the encoded season
+	uint32_t offset;
+	uint32_t varint_size;
+	uint32_t rans_size;
+	uint16_t frequencies[256];
+};
+
+int _field_size (int field, int tiles, int corners, int edges) {
+	return field < 5 ? tiles : field < 6 ? corners : edges;
+}
+
+int _field_offset (int field, int tiles, int corners, int edges) {
+	int offset = 0;
+	for (int i=0; i<field; i++)
+		offset += _field_size(i, tiles, corners, edges);
+	return offset;
+}
+
+int32_t quantize (float f, int mantissa_bits) {
+	uint32_t u;
+	std::memcpy(&u, &f, sizeof(u));
+	// integer order matches float order, negative values have their magnitude bits flipped
+	int32_t o = u & 0x80000000 ? (int32_t)(u ^ 0x7fffffff) : (int32_t)u;
+	int drop = 23 - mantissa_bits;
+	return (int32_t)(((int64_t)o + (1 << (drop-1))) >> drop);
+}
+
+float dequantize (int32_t q, int mantissa_bits) {
+	int32_t o = (int32_t)((uint32_t)q << (23 - mantissa_bits));
+	uint32_t u = o < 0 ? (uint32_t)o ^ 0x7fffffff : (uint32_t)o;
+	float f;
+	std::memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+void quantize_season (const Season& s, std::vector<int32_t>& values) {
+	int tiles = s.tiles.size();
+	int corners = s.corners.size();
+	int edges = s.edges.size();
+	values.resize(5*tiles + corners + 2*edges);
+	int32_t* v = values.data();
+	for (const Climate_tile& t : s.tiles) *v++ = quantize(t.temperature, field_mantissa_bits[0]);
+	for (const Climate_tile& t : s.tiles) *v++ = quantize(t.humidity, field_mantissa_bits[1]);
+	for (const Climate_tile& t : s.tiles) *v++ = quantize(t.precipitation, field_mantissa_bits[2]);
+	for (const Climate_tile& t : s.tiles) *v++ = quantize(t.wind.direction, field_mantissa_bits[3]);
+	for (const Climate_tile& t : s.tiles) *v++ = quantize(t.wind.speed, field_mantissa_bits[4]);
+	for (const Climate_corner& c : s.corners) *v++ = quantize(c.river_flow_increase, field_mantissa_bits[5]);
+	for (const Climate_edge& e : s.edges) *v++ = quantize(e.wind_velocity, field_mantissa_bits[6]);
+	for (const Climate_edge& e : s.edges) *v++ = quantize(e.river_flow, field_mantissa_bits[7]);
+}
+
+void _dequantize_field (int field, const int32_t* v, Season& s) {
+	int bits = field_mantissa_bits[field];
+	switch (field) {
+		case 0: for (Climate_tile& t : s.tiles) t.temperature = dequantize(*v++, bits); break;
+		case 1: for (Climate_tile& t : s.tiles) t.humidity = dequantize(*v++, bits); break;
+		case 2: for (Climate_tile& t : s.tiles) t.precipitation = dequantize(*v++, bits); break;
+		case 3: for (Climate_tile& t : s.tiles) t.wind.direction = dequantize(*v++, bits); break;
+		case 4: for (Climate_tile& t : s.tiles) t.wind.speed = dequantize(*v++, bits); break;
+		case 5: for (Climate_corner& c : s.corners) c.river_flow_increase = dequantize(*v++, bits); break;
+		case 6: for (Climate_edge& e : s.edges) e.wind_velocity = dequantize(*v++, bits); break;
+		case 7: for (Climate_edge& e : s.edges) e.river_flow = dequantize(*v++, bits); break;
+	}
+}
+
+// frequencies summing to rans_scale, at least 1 for every byte that occurs
+void _normalize_frequencies (const uint32_t* counts, uint16_t* frequencies) {
+	uint64_t total = 0;
+	for (int i=0; i<256; i++)
+		total += counts[i];
+	if (total == 0) {
+		std::fill(frequencies, frequencies + 256, 0);
+		frequencies[0] = rans_scale;
+		return;
+	}
+	int sum = 0;
+	for (int i=0; i<256; i++) {
+		frequencies[i] = counts[i] == 0 ? 0 : std::max<uint64_t>(1, counts[i] * rans_scale / total);
+		sum += frequencies[i];
+	}
+	int largest = std::max_element(frequencies, frequencies + 256) - frequencies;
+	if (sum < (int)rans_scale)
+		frequencies[largest] += rans_scale - sum;
+	while (sum > (int)rans_scale) {
+		largest = std::max_element(frequencies, frequencies + 256) - frequencies;
+		int take = std::min(sum - (int)rans_scale, frequencies[largest] - 1);
+		frequencies[largest] -= take;
+		sum -= take;
+	}
+}
+
+// zigzag varint residuals of one field, entropy coded
+void _encode_stream (const int32_t* residuals, int count, Season_codec_stream& stream, std::vector<unsigned char>& out) {
+	std::vector<unsigned char> bytes;
+	bytes.reserve(2*count);
+	for (int i=0; i<count; i++) {
+		uint32_t z = ((uint32_t)residuals[i] << 1) ^ (uint32_t)(residuals[i] >> 31);
+		while (z >= 0x80) {
+			bytes.push_back((z & 0x7f) | 0x80);
+			z >>= 7;
+		}
+		bytes.push_back(z);
+	}
+	stream.varint_size = bytes.size();
+	uint32_t counts[256] = {};
+	for (unsigned char b : bytes)
+		counts[b]++;
+	_normalize_frequencies(counts, stream.frequencies);
+	uint32_t cumulative[256];
+	uint32_t c = 0;
+	for (int k=0; k<256; k++) {
+		cumulative[k] = c;
+		c += stream.frequencies[k];
+	}
+
+	// rans emits bytes in reverse, so the decoder reads them forwards
+	out.resize(2*bytes.size() + 8);
+	unsigned char* end = out.data() + out.size();
+	unsigned char* p = end;
+	uint32_t x = rans_low;
+	for (size_t k = bytes.size(); k > 0; k--) {
+		unsigned char b = bytes[k-1];
+		uint32_t f = stream.frequencies[b];
+		uint32_t x_max = ((rans_low >> rans_bits) << 8) * f;
+		while (x >= x_max) {
+			*--p = x & 0xff;
+			x >>= 8;
+		}
+		x = ((x / f) << rans_bits) + (x % f) + cumulative[b];
+	}
+	for (int k=0; k<4; k++)
+		*--p = (x >> (8*k)) & 0xff;
+	stream.rans_size = end - p;
+	out.erase(out.begin(), out.begin() + (p - out.data()));
+}
+
+void encode_season (std::vector<unsigned char>& out, const Season& s, int index, int reference, const std::vector<int32_t>* keyframe) {
+	int tiles = s.tiles.size();
+	int corners = s.corners.size();
+	int edges = s.edges.size();
+	std::vector<int32_t> values;
+	quantize_season(s, values);
+
+	// keyframes store the difference to the previous element, other seasons the difference to the keyframe
+	std::vector<int32_t> residuals(values.size());
+	for (int field=0; field<field_count; field++) {
+		int first = _field_offset(field, tiles, corners, edges);
+		int last = first + _field_size(field, tiles, corners, edges);
+		for (int i=first; i<last; i++)
+			residuals[i] = keyframe ? values[i] - (*keyframe)[i] : values[i] - (i > first ? values[i-1] : 0);
+	}
+
+	Season_codec_stream streams[field_count];
+	std::vector<unsigned char> encoded[field_count];
+	parallel_for(0, field_count, 1, [&](int first_field, int last_field) {
+		for (int field=first_field; field<last_field; field++)
+			_encode_stream(&residuals[_field_offset(field, tiles, corners, edges)],
+				_field_size(field, tiles, corners, edges), streams[field], encoded[field]);
+	});
+
+	Season_codec_header h;
+	h.index = index;
+	h.reference = reference;
+	h.tile_count = tiles;
+	h.corner_count = corners;
+	h.edge_count = edges;
+	size_t size = sizeof(h) + sizeof(streams);
+	for (int field=0; field<field_count; field++) {
+		streams[field].offset = size;
+		size += encoded[field].size();
+	}
+	out.resize(size);
+	std::memcpy(out.data(), &h, sizeof(h));
+	std::memcpy(out.data() + sizeof(h), streams, sizeof(streams));
+	for (int field=0; field<field_count; field++)
+		std::memcpy(out.data() + streams[field].offset, encoded[field].data(), encoded[field].size());
+}
+
+int season_reference (const unsigned char* data, size_t size) {
+	if (size < sizeof(Season_codec_header) + field_count * sizeof(Season_codec_stream))
+		return -1;
+	Season_codec_header h;
+	std::memcpy(&h, data, sizeof(h));
+	return h.reference;
+}
+
+// residuals of one stream, false if the data is malformed
+bool _decode_stream (const Season_codec_stream& stream, const unsigned char* data, size_t size, int32_t* v, int count) {
+	if (stream.rans_size < 4 || stream.offset > size || stream.rans_size > size - stream.offset)
+		return false;
+	uint32_t cumulative[256];
+	uint32_t c = 0;
+	for (int k=0; k<256; k++) {
+		cumulative[k] = c;
+		c += stream.frequencies[k];
+	}
+	if (c != rans_scale)
+		return false;
+	unsigned char symbols[rans_scale];
+	for (int k=0; k<256; k++)
+		std::fill(symbols + cumulative[k], symbols + cumulative[k] + stream.frequencies[k], k);
+
+	const unsigned char* p = data + stream.offset;
+	const unsigned char* end = p + stream.rans_size;
+	uint32_t x = (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+	p += 4;
+
+	int32_t* v_end = v + count;
+	uint32_t z = 0;
+	int shift = 0;
+	for (uint32_t k=0; k<stream.varint_size; k++) {
+		uint32_t slot = x & (rans_scale - 1);
+		unsigned char b = symbols[slot];
+		x = stream.frequencies[b] * (x >> rans_bits) + slot - cumulative[b];
+		while (x < rans_low && p < end)
+			x = (x << 8) | *p++;
+		z |= (uint32_t)(b & 0x7f) << shift;
+		if (b & 0x80) {
+			shift += 7;
+			if (shift > 28)
+				return false;
+			continue;
+		}
+		if (v == v_end)
+			return false;
+		*v++ = (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+		z = 0;
+		shift = 0;
+	}
+	return v == v_end;
+}
+
+// quantized values of one field, keyframe values must already be in the decoder unless this is the keyframe
+bool _decode_field (Season_decoder& d, const Season_codec_header& h, const Season_codec_stream& stream, const unsigned char* data, size_t size, int field) {
+	int offset = _field_offset(field, h.tile_count, h.corner_count, h.edge_count);
+	int count = _field_size(field, h.tile_count, h.corner_count, h.edge_count);
+	int32_t* v = d.values.data() + offset;
+	if (!_decode_stream(stream, data, size, v, count))
+		return false;
+	if (h.index == h.reference) {
+		for (int i=1; i<count; i++)
+			v[i] += v[i-1];
+	}
+	else {
+		const int32_t* key = d.key.data() + offset;
+		for (int i=0; i<count; i++)
+			v[i] += key[i];
+	}
+	return true;
+}
+
+// counts in a header are checked against the planet's before any of them sizes a buffer
+bool _matching_counts (const Season_codec_header& h, int tiles, int corners, int edges) {
+	return tiles >= 0 && corners >= 0 && edges >= 0 &&
+		h.tile_count == (uint32_t)tiles && h.corner_count == (uint32_t)corners && h.edge_count == (uint32_t)edges;
+}
+
+// decodes all fields into d.values, calling f(field) on each as it completes
+bool _decode_values (Season_decoder& d, const unsigned char* data, size_t size, int tiles, int corners, int edges, const std::function<void (int)>& f) {
+	if (season_reference(data, size) < 0)
+		return false;
+	Season_codec_header h;
+	Season_codec_stream streams[field_count];
+	std::memcpy(&h, data, sizeof(h));
+	std::memcpy(streams, data + sizeof(h), sizeof(streams));
+	if (!_matching_counts(h, tiles, corners, edges))
+		return false;
+	size_t count = (size_t)5*h.tile_count + h.corner_count + 2*h.edge_count;
+	if (h.index != h.reference && d.key.size() != count)
+		return false;
+	d.values.resize(count);
+	std::atomic<bool> valid(true);
+	parallel_for(0, field_count, 1, [&](int first_field, int last_field) {
+		for (int field=first_field; field<last_field; field++) {
+			if (!_decode_field(d, h, streams[field], data, size, field))
+				valid = false;
+			else
+				f(field);
+		}
+	});
+	return valid;
+}
+
+bool decode_season (Season_decoder& d, const unsigned char* data, size_t size, const unsigned char* key_data, size_t key_size,
+	int tiles, int corners, int edges, Season& s) {
+	if (season_reference(data, size) < 0)
+		return false;
+	Season_codec_header h;
+	std::memcpy(&h, data, sizeof(h));
+	if (!_matching_counts(h, tiles, corners, edges))
+		return false;
+	bool keyframe = h.index == h.reference;
+
+	if (!keyframe && d.key_data != key_data) {
+		Season_codec_header key_header;
+		if (!key_data || season_reference(key_data, key_size) != (int)h.reference)
+			return false;
+		std::memcpy(&key_header, key_data, sizeof(key_header));
+		if (key_header.index != h.reference || !_decode_values(d, key_data, key_size, tiles, corners, edges, [](int) {}))
+			return false;
+		d.key.swap(d.values);
+		d.key_data = key_data;
+	}
+
+	s.tiles.resize(h.tile_count);
+	s.corners.resize(h.corner_count);
+	s.edges.resize(h.edge_count);
+	// fields are converted back to floats on the thread that decoded them
+	if (!_decode_values(d, data, size, tiles, corners, edges, [&](int field) {
+		int offset = _field_offset(field, h.tile_count, h.corner_count, h.edge_count);
+		_dequantize_field(field, d.values.data() + offset, s);
+	}))
+		return false;
+	if (keyframe) {
+		d.key = d.values;
+		d.key_data = data;
+	}
+	return true;
+}
+
+void init_compressed_climate (Compressed_climate& c, const Planet& p, int keyframe_interval) {
+	c.keyframe_interval = std::max(1, keyframe_interval);
+	c.tile_count = tile_count(p);
+	c.corner_count = corner_count(p);
+	c.edge_count = edge_count(p);
+	c.seasons.clear();
+	c.keyframe.clear();
+}
+
+void append_season (Compressed_climate& c, const Season& s) {
+	int index = c.seasons.size();
+	int reference = index - index % c.keyframe_interval;
+	c.seasons.push_back(std::vector<unsigned char>());
+	if (index == reference) {
+		encode_season(c.seasons.back(), s, index, reference, nullptr);
+		quantize_season(s, c.keyframe);
+	}
+	else
+		encode_season(c.seasons.back(), s, index, reference, &c.keyframe);
+}
+
+bool decode_season (Season_decoder& d, const Compressed_climate& c, int n, Season& s) {
+	if (n < 0 || n >= (int)c.seasons.size())
+		return false;
+	int reference = season_reference(c.seasons[n].data(), c.seasons[n].size());
+	if (reference < 0 || reference >= (int)c.seasons.size())
+		return false;
+	const std::vector<unsigned char>& key = c.seasons[reference];
+	return decode_season(d, c.seasons[n].data(), c.seasons[n].size(), key.data(), key.size(),
+		c.tile_count, c.corner_count, c.edge_count, s);
+}
+
+size_t compressed_size (const Compressed_climate& c) {
+	size_t size = 0;
+	for (auto& s : c.seasons)
+		size += s.size();
+	return size;
+}
+
+size_t raw_season_size (const Compressed_climate& c) {
+	return sizeof(float) * ((size_t)5*c.tile_count + c.corner_count + 2*c.edge_count);
+}
@@ -0,0 +1,64 @@
+#ifndef season_codec_h
+#define season_codec_h
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+class Planet;
+class Season;
+
+// seasons from one keyframe to the next, unless given otherwise
+const int default_keyframe_interval = 8;
+
+// lossy season compression. values are rounded to a fixed number of mantissa bits,
+// keyframes store differences between consecutive elements and other seasons store
+// differences to their keyframe, all zigzag varint coded and entropy coded with rans
+class Compressed_climate {
+public:
+	Compressed_climate () :
+		keyframe_interval (default_keyframe_interval), tile_count (0), corner_count (0), edge_count (0) {}
+
+	int keyframe_interval;
+	int tile_count;
+	int corner_count;
+	int edge_count;
+	std::vector<std::vector<unsigned char>> seasons;
+	// quantized values of the latest keyframe, needed while appending
+	std::vector<int32_t> keyframe;
+};
+
+// caches the quantized values of the last keyframe decoded, so stepping through
+// seasons only decodes one season each step
+class Season_decoder {
+public:
+	Season_decoder () :
+		key_data (nullptr) {}
+
+	const unsigned char* key_data;
+	std::vector<int32_t> key;
+	std::vector<int32_t> values;
+	std::vector<unsigned char> bytes;
+};
+
+void init_compressed_climate (Compressed_climate&, const Planet&, int keyframe_interval);
+void append_season (Compressed_climate&, const Season&);
+bool decode_season (Season_decoder&, const Compressed_climate&, int, Season&);
+size_t compressed_size (const Compressed_climate&);
+// size of a season's values as stored uncompressed
+size_t raw_season_size (const Compressed_climate&);
+
+// encodes a season on its own, or against a keyframe given its quantized values
+void encode_season (std::vector<unsigned char>&, const Season&, int index, int reference, const std::vector<int32_t>* keyframe);
+// index of the keyframe an encoded season refers to, its own index for keyframes
+int season_reference (const unsigned char*, size_t);
+// key_data is the encoded keyframe, ignored when decoding a keyframe. fails without allocating
+// anything when the counts stored in either season differ from the ones given
+bool decode_season (Season_decoder&, const unsigned char* data, size_t size, const unsigned char* key_data, size_t key_size,
+	int tile_count, int corner_count, int edge_count, Season&);
+
+// quantized values of a season in field order
+void quantize_season (const Season&, std::vector<int32_t>&);
+int32_t quantize (float, int mantissa_bits);
+float dequantize (int32_t, int mantissa_bits);
+
+#endif
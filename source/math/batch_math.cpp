@@ -0,0 +1,131 @@
+#include "batch_math.h"
+#include "matrix3.h"
+#include <cmath>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define BATCH_MATH_SSE
+#endif
+
+int size (const Vector3_array& a) {
+	return a.x.size();
+}
+
+void resize (Vector3_array& a, int n) {
+	a.x.resize(n);
+	a.y.resize(n);
+	a.z.resize(n);
+}
+
+void set (Vector3_array& a, int i, const Vector3& v) {
+	a.x[i] = v.x;
+	a.y[i] = v.y;
+	a.z[i] = v.z;
+}
+
+Vector3 get (const Vector3_array& a, int i) {
+	return Vector3(a.x[i], a.y[i], a.z[i]);
+}
+
+void transform (const Matrix3& m, const Vector3_array& in, Vector3_array& out, int first, int last) {
+	float r[3][3];
+	for (int i=0; i<3; i++)
+		for (int k=0; k<3; k++)
+			r[i][k] = m.m[i][k];
+	const float* x = in.x.data();
+	const float* y = in.y.data();
+	const float* z = in.z.data();
+	float* ox = out.x.data();
+	float* oy = out.y.data();
+	float* oz = out.z.data();
+	int i = first;
+#ifdef BATCH_MATH_SSE
+	__m128 m00 = _mm_set1_ps(r[0][0]), m01 = _mm_set1_ps(r[0][1]), m02 = _mm_set1_ps(r[0][2]);
+	__m128 m10 = _mm_set1_ps(r[1][0]), m11 = _mm_set1_ps(r[1][1]), m12 = _mm_set1_ps(r[1][2]);
+	__m128 m20 = _mm_set1_ps(r[2][0]), m21 = _mm_set1_ps(r[2][1]), m22 = _mm_set1_ps(r[2][2]);
+	for (; i+4 <= last; i+=4) {
+		__m128 vx = _mm_loadu_ps(x+i);
+		__m128 vy = _mm_loadu_ps(y+i);
+		__m128 vz = _mm_loadu_ps(z+i);
+		_mm_storeu_ps(ox+i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m00), _mm_mul_ps(vy, m01)), _mm_mul_ps(vz, m02)));
+		_mm_storeu_ps(oy+i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m10), _mm_mul_ps(vy, m11)), _mm_mul_ps(vz, m12)));
+		_mm_storeu_ps(oz+i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m20), _mm_mul_ps(vy, m21)), _mm_mul_ps(vz, m22)));
+	}
+#endif
+	for (; i<last; i++) {
+		float vx = x[i], vy = y[i], vz = z[i];
+		ox[i] = vx*r[0][0] + vy*r[0][1] + vz*r[0][2];
+		oy[i] = vx*r[1][0] + vy*r[1][1] + vz*r[1][2];
+		oz[i] = vx*r[2][0] + vy*r[2][1] + vz*r[2][2];
+	}
+}
+
+void transform (const Matrix3& m, const Vector3_array& in, Vector3_array& out) {
+	if (&out != &in)
+		resize(out, size(in));
+	transform(m, in, out, 0, size(in));
+}
+
+void normalize (Vector3_array& a, int first, int last) {
+	float* x = a.x.data();
+	float* y = a.y.data();
+	float* z = a.z.data();
+	int i = first;
+#ifdef BATCH_MATH_SSE
+	// full precision square root and division, the reciprocal estimates are only good to 12 bits
+	__m128 one = _mm_set1_ps(1.0f);
+	for (; i+4 <= last; i+=4) {
+		__m128 vx = _mm_loadu_ps(x+i);
+		__m128 vy = _mm_loadu_ps(y+i);
+		__m128 vz = _mm_loadu_ps(z+i);
+		__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)));
+		__m128 d = _mm_div_ps(one, length);
+		_mm_storeu_ps(x+i, _mm_mul_ps(vx, d));
+		_mm_storeu_ps(y+i, _mm_mul_ps(vy, d));
+		_mm_storeu_ps(z+i, _mm_mul_ps(vz, d));
+	}
+#endif
+	for (; i<last; i++) {
+		float d = 1.0f / std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+		x[i] *= d;
+		y[i] *= d;
+		z[i] *= d;
+	}
+}
+
+void normalize (Vector3_array& a) {
+	normalize(a, 0, size(a));
+}
+
+void dot_products (const Vector3_array& a, const Vector3_array& b, std::vector<float>& out, int first, int last) {
+	const float* ax = a.x.data();
+	const float* ay = a.y.data();
+	const float* az = a.z.data();
+	const float* bx = b.x.data();
+	const float* by = b.y.data();
+	const float* bz = b.z.data();
+	float* o = out.data();
+	int i = first;
+#ifdef BATCH_MATH_SSE
+	for (; i+4 <= last; i+=4) {
+		__m128 d = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(ax+i), _mm_loadu_ps(bx+i)), _mm_mul_ps(_mm_loadu_ps(ay+i), _mm_loadu_ps(by+i))),
+			_mm_mul_ps(_mm_loadu_ps(az+i), _mm_loadu_ps(bz+i)));
+		_mm_storeu_ps(o+i, d);
+	}
+#endif
+	for (; i<last; i++)
+		o[i] = ax[i]*bx[i] + ay[i]*by[i] + az[i]*bz[i];
+}
+
+void dot_products (const Vector3_array& a, const Vector3_array& b, std::vector<float>& out) {
+	out.resize(size(a));
+	dot_products(a, b, out, 0, size(a));
+}
+
+bool batch_math_simd () {
+#ifdef BATCH_MATH_SSE
+	return true;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,37 @@
+#ifndef batch_math_h
+#define batch_math_h
+
+#include <vector>
+#include "vector3.h"
+class Matrix3;
+
+// vectors stored as separate x, y and z arrays, so batch operations handle four at a time with sse.
+// batch results are computed in single precision, unlike the Vector3 functions
+class Vector3_array {
+public:
+	Vector3_array () {}
+
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+};
+
+int size (const Vector3_array&);
+void resize (Vector3_array&, int);
+void set (Vector3_array&, int, const Vector3&);
+Vector3 get (const Vector3_array&, int);
+
+// out[i] = m * in[i] for i in [first, last), out may be in
+void transform (const Matrix3&, const Vector3_array& in, Vector3_array& out, int first, int last);
+void transform (const Matrix3&, const Vector3_array& in, Vector3_array& out);
+// scales each vector in [first, last) to unit length
+void normalize (Vector3_array&, int first, int last);
+void normalize (Vector3_array&);
+// out[i] = dot product of a[i] and b[i]
+void dot_products (const Vector3_array& a, const Vector3_array& b, std::vector<float>& out, int first, int last);
+void dot_products (const Vector3_array& a, const Vector3_array& b, std::vector<float>& out);
+
+// true when the batch operations use sse rather than the scalar loops
+bool batch_math_simd ();
+
+#endif
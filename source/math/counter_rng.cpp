@@ -0,0 +1,35 @@
+#include "counter_rng.h"
+
+static const uint64_t golden_gamma = 0x9e3779b97f4a7c15ull;
+
+Counter_rng hex_rng (const std::string& s) {
+	uint64_t key = 0;
+	for (unsigned int i=0; i<s.length() && i<16; i++) {
+		char c = s[i];
+		int digit =
+			c >= 'a' && c <= 'f' ? c - 'a' + 10 :
+			c >= 'A' && c <= 'F' ? c - 'A' + 10 :
+			c >= '0' && c <= '9' ? c - '0' : 0;
+		key = key * 16 + digit;
+	}
+	return Counter_rng(key);
+}
+
+Counter_rng substream (const Counter_rng& r, uint64_t stream) {
+	// keys are hashed rather than offset, so nearby streams start far apart in the sequence
+	return Counter_rng(mix64(r.key ^ mix64(stream + golden_gamma)));
+}
+
+uint64_t random_bits (const Counter_rng& r, uint64_t n) {
+	return mix64(r.key + (n + 1) * golden_gamma);
+}
+
+double random_unit (const Counter_rng& r, uint64_t n) {
+	return (random_bits(r, n) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+uint64_t mix64 (uint64_t z) {
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
@@ -0,0 +1,30 @@
+#ifndef counter_rng_h
+#define counter_rng_h
+
+#include <string>
+#include <cstdint>
+
+// counter based random numbers: the n-th value of a stream is a hash of the key and n,
+// so values can be produced in any order, from any thread, and are the same on every platform.
+// values of one key follow the splitmix64 sequence
+class Counter_rng {
+public:
+	Counter_rng (uint64_t k) :
+		key (k) {}
+
+	uint64_t key;
+};
+
+// keyed by up to 16 leading hex digits, as in an md5 digest
+Counter_rng hex_rng (const std::string&);
+// independent generator for a stage or an element, streams of different numbers don't overlap in practice
+Counter_rng substream (const Counter_rng&, uint64_t stream);
+
+uint64_t random_bits (const Counter_rng&, uint64_t n);
+// uniform in [0, 1), with 53 random bits
+double random_unit (const Counter_rng&, uint64_t n);
+
+// splitmix64 finalizer, a bijective mix of all 64 bits
+uint64_t mix64 (uint64_t);
+
+#endif
@@ -0,0 +1,116 @@
+#include "fast_math.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FAST_MATH_SSE
+#endif
+
+#ifdef FAST_MATH_SSE
+// a where mask is set, b elsewhere
+__m128 _select (__m128 mask, __m128 a, __m128 b) {
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+__m128 _abs (__m128 x) {
+	return _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+}
+
+__m128 _sign (__m128 x) {
+	return _mm_and_ps(x, _mm_castsi128_ps(_mm_set1_epi32(0x80000000)));
+}
+
+// p[0] + x*(p[1] + x*(...)), n coefficients
+__m128 _polynomial (__m128 x, const float* p, int n) {
+	__m128 r = _mm_set1_ps(p[n-1]);
+	for (int i=n-2; i>=0; i--)
+		r = _mm_add_ps(_mm_set1_ps(p[i]), _mm_mul_ps(x, r));
+	return r;
+}
+
+const float _atan_coefficients[] = {0.99997726f, -0.33262347f, 0.19354346f, -0.11643287f, 0.05265332f, -0.01172120f};
+const float _acos_coefficients[] = {1.5707963050f, -0.2145988016f, 0.0889789874f, -0.0501743046f, 0.0308918810f, -0.0170881256f, 0.0066700901f, -0.0012624911f};
+const float _sin_coefficients[] = {1.0f, -1.0f/6, 1.0f/120, -1.0f/5040};
+const float _cos_coefficients[] = {1.0f, -0.5f, 1.0f/24, -1.0f/720, 1.0f/40320};
+
+__m128 _acos_unit (__m128 a) {
+	__m128 s = _mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), a), _mm_setzero_ps());
+	return _mm_mul_ps(_mm_sqrt_ps(s), _polynomial(a, _acos_coefficients, 8));
+}
+#endif
+
+void fast_atan2 (const float* y, const float* x, float* out, int n) {
+	int i = 0;
+#ifdef FAST_MATH_SSE
+	for (; i+4 <= n; i+=4) {
+		__m128 vx = _mm_loadu_ps(x+i);
+		__m128 vy = _mm_loadu_ps(y+i);
+		__m128 ax = _abs(vx);
+		__m128 ay = _abs(vy);
+		__m128 larger = _mm_max_ps(ax, ay);
+		__m128 a = _mm_div_ps(_mm_min_ps(ax, ay), larger);
+		a = _mm_and_ps(_mm_cmpgt_ps(larger, _mm_setzero_ps()), a);
+		__m128 r = _mm_mul_ps(a, _polynomial(_mm_mul_ps(a, a), _atan_coefficients, 6));
+		r = _select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(fast_pi/2), r), r);
+		r = _select(_mm_cmplt_ps(vx, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(fast_pi), r), r);
+		r = _select(_mm_cmplt_ps(vy, _mm_setzero_ps()), _mm_sub_ps(_mm_setzero_ps(), r), r);
+		_mm_storeu_ps(out+i, r);
+	}
+#endif
+	for (; i<n; i++)
+		out[i] = fast_atan2(y[i], x[i]);
+}
+
+void fast_asin (const float* x, float* out, int n) {
+	int i = 0;
+#ifdef FAST_MATH_SSE
+	for (; i+4 <= n; i+=4) {
+		__m128 v = _mm_loadu_ps(x+i);
+		__m128 a = _mm_min_ps(_abs(v), _mm_set1_ps(1.0f));
+		__m128 r = _mm_sub_ps(_mm_set1_ps(fast_pi/2), _acos_unit(a));
+		_mm_storeu_ps(out+i, _mm_or_ps(r, _sign(v)));
+	}
+#endif
+	for (; i<n; i++)
+		out[i] = fast_asin(x[i]);
+}
+
+void fast_acos (const float* x, float* out, int n) {
+	int i = 0;
+#ifdef FAST_MATH_SSE
+	for (; i+4 <= n; i+=4) {
+		__m128 v = _mm_loadu_ps(x+i);
+		__m128 r = _acos_unit(_mm_min_ps(_abs(v), _mm_set1_ps(1.0f)));
+		r = _select(_mm_cmplt_ps(v, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(fast_pi), r), r);
+		_mm_storeu_ps(out+i, r);
+	}
+#endif
+	for (; i<n; i++)
+		out[i] = fast_acos(x[i]);
+}
+
+void fast_sincos (const float* x, float* s, float* c, int n) {
+	int i = 0;
+#ifdef FAST_MATH_SSE
+	for (; i+4 <= n; i+=4) {
+		__m128 v = _mm_loadu_ps(x+i);
+		__m128 half = _mm_or_ps(_mm_set1_ps(0.5f), _sign(v));
+		__m128i quadrant = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, _mm_set1_ps(2/fast_pi)), half));
+		__m128 q = _mm_cvtepi32_ps(quadrant);
+		__m128 r = _mm_sub_ps(v, _mm_mul_ps(q, _mm_set1_ps(1.5703125f)));
+		r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(4.837512969970703125e-4f)));
+		r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(7.54978995489188216e-8f)));
+		__m128 r2 = _mm_mul_ps(r, r);
+		__m128 rs = _mm_mul_ps(r, _polynomial(r2, _sin_coefficients, 4));
+		__m128 rc = _polynomial(r2, _cos_coefficients, 5);
+		__m128 odd = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+		__m128 sine = _select(odd, rc, rs);
+		__m128 cosine = _select(odd, rs, rc);
+		// the sign bit of quadrant & 2 moved to bit 31
+		__m128 sine_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+		__m128 cosine_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+		_mm_storeu_ps(s+i, _mm_xor_ps(sine, sine_sign));
+		_mm_storeu_ps(c+i, _mm_xor_ps(cosine, cosine_sign));
+	}
+#endif
+	for (; i<n; i++)
+		fast_sincos(x[i], s[i], c[i]);
+}
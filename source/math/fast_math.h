@@ -0,0 +1,84 @@
+#ifndef fast_math_h
+#define fast_math_h
+
+#include <cmath>
+
+// polynomial approximations of the trigonometric functions in single precision, for loops over
+// every tile or corner where the library functions dominate. the array versions use sse four
+// values at a time. call sites opt in, anything stored or compared across versions keeps std::
+//
+// largest absolute errors in radians, as measured against the double precision library functions
+// by the fast_math benchmark:
+const float fast_atan2_error = 5.0e-6f;
+const float fast_asin_error = 5.0e-7f;
+const float fast_acos_error = 5.0e-7f;
+// for |x| <= fast_sincos_range, range reduction loses precision for larger arguments
+const float fast_sincos_error = 5.0e-7f;
+const float fast_sincos_range = 1000.0f;
+
+const float fast_pi = 3.14159265358979f;
+
+// minimax polynomial on [0, 1]
+inline float _fast_atan_unit (float a) {
+	float s = a*a;
+	return a * (0.99997726f + s*(-0.33262347f + s*(0.19354346f + s*(-0.11643287f + s*(0.05265332f + s*-0.01172120f)))));
+}
+
+// same as std::atan2 except 0 for (0, 0)
+inline float fast_atan2 (float y, float x) {
+	float ax = std::fabs(x);
+	float ay = std::fabs(y);
+	float larger = ax > ay ? ax : ay;
+	float smaller = ax > ay ? ay : ax;
+	float r = _fast_atan_unit(larger > 0 ? smaller / larger : 0);
+	r = ay > ax ? fast_pi/2 - r : r;
+	r = x < 0 ? fast_pi - r : r;
+	return y < 0 ? -r : r;
+}
+
+// abramowitz and stegun 4.4.46, acos(x) = sqrt(1-x) * p(x) on [0, 1]
+inline float _fast_acos_unit (float a) {
+	float p = 1.5707963050f + a*(-0.2145988016f + a*(0.0889789874f + a*(-0.0501743046f + a*(0.0308918810f + a*(-0.0170881256f + a*(0.0066700901f + a*-0.0012624911f))))));
+	float s = 1.0f - a;
+	return std::sqrt(s > 0 ? s : 0) * p;
+}
+
+// arguments are clamped to [-1, 1]
+inline float fast_asin (float x) {
+	float a = std::fabs(x);
+	a = a < 1 ? a : 1;
+	float r = fast_pi/2 - _fast_acos_unit(a);
+	return x < 0 ? -r : r;
+}
+
+inline float fast_acos (float x) {
+	float a = std::fabs(x);
+	a = a < 1 ? a : 1;
+	float r = _fast_acos_unit(a);
+	return x < 0 ? fast_pi - r : r;
+}
+
+// reduced to [-pi/4, pi/4] by quarter turns, then taylor polynomials
+inline void fast_sincos (float x, float& s, float& c) {
+	// rounded to the nearest quarter turn
+	int quadrant = (int)(x * (2/fast_pi) + (x < 0 ? -0.5f : 0.5f));
+	float q = (float)quadrant;
+	// pi/2 in three parts with few enough bits that q times each is exact for |q| < 8192
+	float r = ((x - q*1.5703125f) - q*4.837512969970703125e-4f) - q*7.54978995489188216e-8f;
+	float r2 = r*r;
+	float rs = r * (1.0f + r2*(-1.0f/6 + r2*(1.0f/120 + r2*(-1.0f/5040))));
+	float rc = 1.0f + r2*(-0.5f + r2*(1.0f/24 + r2*(-1.0f/720 + r2*(1.0f/40320))));
+	quadrant &= 3;
+	float sine = quadrant & 1 ? rc : rs;
+	float cosine = quadrant & 1 ? rs : rc;
+	s = quadrant & 2 ? -sine : sine;
+	c = (quadrant + 1) & 2 ? -cosine : cosine;
+}
+
+// the scalar functions over arrays, within the same error bounds, out may be one of the inputs
+void fast_atan2 (const float* y, const float* x, float* out, int n);
+void fast_asin (const float* x, float* out, int n);
+void fast_acos (const float* x, float* out, int n);
+void fast_sincos (const float* x, float* s, float* c, int n);
+
+#endif
@@ -1,20 +1,59 @@
 #include "climate_generation.h"
+#include "../generation_context.h"
 #include "../../math/matrix2.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
 
 void generate_climate (Planet& planet, const Climate_parameters& par) {
-	clear_climate(planet);
-	m_terrain(planet).var.axial_tilt = par.axial_tilt;
-	m_climate(planet).var.season_count = par.seasons;
-	std::cout << "seasons: ";
+	Generation_context c = console_context();
+	generate_climate(planet, par, c);
+}
+
+void generate_climate (Planet& planet, const Climate_parameters& par, const std::function<void (int, const Season&)>& f) {
+	Generation_context c = console_context();
+	generate_climate(planet, par, f, c);
+}
+
+bool generate_climate (Planet& planet, const Climate_parameters& par, Generation_context& c) {
+	bool complete = generate_climate(planet, par, [&planet](int, const Season& s) {
+		m_climate(planet).seasons.push_back(s);
+	}, c);
+	m_climate(planet).var.season_count = climate(planet).seasons.size();
+	return complete;
+}
+
+bool generate_climate (Planet& planet, const Climate_parameters& par, const std::function<void (int, const Season&)>& f, Generation_context& c) {
+	init_climate(planet, par);
+	return generate_seasons(planet, par, f, c);
+}
+
+bool generate_seasons (const Planet& planet, const Climate_parameters& par, const std::function<void (int, const Season&)>& f, Generation_context& c) {
+	Generation_threads threads(c);
+	Season s;
+	if (c.log)
+		*c.log << "seasons: ";
 	for (int i=0; i<par.seasons; i++) {
-		std::cout << i << std::flush;
-		generate_season(planet, par, (float)i/par.seasons);
-		std::cout << ", ";
+		bool started = next_stage(c, "season");
+		if (started && c.log)
+			*c.log << i << std::flush;
+		// each season is timed as a whole, its own stages go to a context of its own
+		Generation_context season_context;
+		season_context.cancel = c.cancel;
+		if (!started || generate_season(planet, par, (float)i/par.seasons, s, season_context) < 0) {
+			end_stage(c);
+			if (c.log)
+				*c.log << (started ? ", cancelled\n" : "cancelled\n");
+			return false;
+		}
+		f(i, s);
+		if (c.log)
+			*c.log << ", ";
 	}
-	std::cout << "done\n";
+	end_stage(c);
+	if (c.log)
+		*c.log << "done\n";
+	return true;
 }
 
 void copy_season (const Climate_generation_season& from, Season& to) {
@@ -28,7 +67,23 @@ void copy_season (const Climate_generation_season& from, Season& to) {
 	}
 }
 
+void init_climate (Planet& planet, const Climate_parameters& par) {
+	clear_climate(planet);
+	m_terrain(planet).var.axial_tilt = par.axial_tilt;
+}
+
 void generate_season (Planet& planet, const Climate_parameters& par, float time_of_year) {
+	Season s;
+	generate_season(planet, par, time_of_year, s);
+	m_climate(planet).seasons.push_back(s);
+}
+
+void generate_season (const Planet& planet, const Climate_parameters& par, float time_of_year, Season& s) {
+	Generation_context c;
+	generate_season(planet, par, time_of_year, s, c);
+}
+
+int generate_season (const Planet& planet, const Climate_parameters& par, float time_of_year, Season& s, Generation_context& c) {
 	Climate_generation_season season;
 	season.tiles.resize(tile_count(planet));
 	season.corners.resize(corner_count(planet));
@@ -38,17 +93,23 @@ void generate_season (Planet& planet, const Climate_parameters& par, float time_
 	season.var.solar_equator = axial_tilt(planet) * sin(2.0*pi*time_of_year);
 	season.tropical_equator = 0.67*season.var.solar_equator;
 	
+	begin_stage(c, "temperature");
 	_set_temperature(planet, par, season);
+	begin_stage(c, "wind");
 	_set_wind(planet, par, season);
-	_set_humidity(planet, par, season);
+	begin_stage(c, "humidity");
+	int sweeps = _set_humidity(planet, par, season, c);
+	end_stage(c);
+	if (cancelled(c))
+		return -1;
 //	_set_river_flow(planet, par, season);
 	
-	Season s;
+	s = Season();
 	s.tiles.resize(tile_count(planet));
 	s.corners.resize(corner_count(planet));
 	s.edges.resize(edge_count(planet));
 	copy_season(season, s);
-	m_climate(planet).seasons.push_back(s);
+	return sweeps;
 }
 
 void _set_temperature (const Planet& planet, const Climate_parameters&, Climate_generation_season& season) {
@@ -183,14 +244,16 @@ float _humidity_change (float first, float second) {
 	return 1.0f - first/second;
 }
 
-void _iterate_humidity (const Planet& planet, const Climate_parameters& par, Climate_generation_season& season) {
+int _iterate_humidity (const Planet& planet, const Climate_parameters& par, Climate_generation_season& season, const Generation_context& c) {
 	std::deque<float> humidity;
 	std::deque<float> precipitation;
 	humidity.resize(tile_count(planet));
 	precipitation.resize(tile_count(planet));
 	
 	float delta = 1.0;
-	while (delta > par.error_tolerance) {
+	int sweeps = 0;
+	while (delta > par.error_tolerance && !cancelled(c)) {
+		sweeps++;
 //		std::cout << "delta: " << delta << "\n";
 		for (int i=0; i<tile_count(planet); i++) {
 			precipitation[i] = 0.0;
@@ -235,9 +298,10 @@ void _iterate_humidity (const Planet& planet, const Climate_parameters& par, Cli
 			season.tiles[i].precipitation = precipitation[i];
 		}
 	}
+	return sweeps;
 }
 
-void _set_humidity (const Planet& planet, const Climate_parameters& par, Climate_generation_season& season) {
+int _set_humidity (const Planet& planet, const Climate_parameters& par, Climate_generation_season& season, const Generation_context& c) {
 	for (auto& t : tiles(planet)) {
 		float humidity = 0.0;		
 		if (is_water(nth_tile(terrain(planet), id(t)))) {
@@ -245,7 +309,7 @@ void _set_humidity (const Planet& planet, const Climate_parameters& par, Climate
 		}
 		season.tiles[id(t)].humidity = humidity;
 	}
-	_iterate_humidity(planet, par, season);
+	return _iterate_humidity(planet, par, season, c);
 }
 
 int _lowest_corner (const Planet&, const Tile&) {
@@ -4,13 +4,32 @@
 #include "../planet.h"
 #include "climate.h"
 #include "climate_generation_season.h"
+#include <functional>
+class Generation_context;
 
 void generate_climate (Planet&, const Climate_parameters&);
+// passes each season to f as it is generated instead of storing it, the planet is left without seasons
+void generate_climate (Planet&, const Climate_parameters&, const std::function<void (int, const Season&)>&);
+// as above, false if cancelled through the context, leaving only the seasons generated so far
+bool generate_climate (Planet&, const Climate_parameters&, Generation_context&);
+bool generate_climate (Planet&, const Climate_parameters&, const std::function<void (int, const Season&)>&, Generation_context&);
+// clears seasons and sets the variables seasons are generated from, as generate_climate does first
+void init_climate (Planet&, const Climate_parameters&);
+// the rest of generate_climate, passing each season to f, for a planet init_climate was called on.
+// leaves the planet unchanged, so it can be read elsewhere while this runs
+bool generate_seasons (const Planet&, const Climate_parameters&, const std::function<void (int, const Season&)>&, Generation_context&);
 void generate_season (Planet&, const Climate_parameters&, float);
+void generate_season (const Planet&, const Climate_parameters&, float, Season&);
+// as above, timing the temperature, wind and humidity stages in the context, returns the humidity sweeps,
+// or -1 if cancelled through the context, leaving the season unchanged
+int generate_season (const Planet&, const Climate_parameters&, float, Season&, Generation_context&);
 
 void _set_temperature (const Planet&, const Climate_parameters&, Climate_generation_season&);
 void _set_wind (const Planet&, const Climate_parameters&, Climate_generation_season&);
-void _set_humidity (const Planet&, const Climate_parameters&, Climate_generation_season&);
+// both return the number of sweeps until humidity changed less than the error tolerance,
+// sweeps stop early once cancelled through the context
+int _set_humidity (const Planet&, const Climate_parameters&, Climate_generation_season&, const Generation_context&);
+int _iterate_humidity (const Planet&, const Climate_parameters&, Climate_generation_season&, const Generation_context&);
 void _set_river_flow (const Planet&, const Climate_parameters&, Climate_generation_season&);
 	
 #endif
@@ -0,0 +1,58 @@
+#include "generation_context.h"
+#include "../thread/parallel.h"
+#include <iostream>
+
+bool cancelled (const Generation_context& c) {
+	return c.cancel && c.cancel->load();
+}
+
+void report_progress (const Generation_context& c, double fraction) {
+	if (c.progress)
+		c.progress(c.stage, fraction);
+}
+
+void begin_stage (Generation_context& c, const std::string& name) {
+	end_stage(c);
+	c.stage = name;
+	c.stage_start = std::chrono::steady_clock::now();
+	report_progress(c, 0);
+}
+
+bool next_stage (Generation_context& c, const std::string& name) {
+	if (cancelled(c)) {
+		end_stage(c);
+		return false;
+	}
+	begin_stage(c, name);
+	return true;
+}
+
+void end_stage (Generation_context& c) {
+	if (c.stage.empty())
+		return;
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - c.stage_start).count();
+	c.stages.push_back(Generation_stage(c.stage, seconds));
+	c.stage.clear();
+}
+
+double total_seconds (const Generation_context& c) {
+	double seconds = 0;
+	for (const Generation_stage& s : c.stages)
+		seconds += s.seconds;
+	return seconds;
+}
+
+Generation_context console_context () {
+	Generation_context c;
+	c.log = &std::cout;
+	return c;
+}
+
+Generation_threads::Generation_threads (const Generation_context& c) :
+	previous (thread_limit()) {
+	set_thread_limit(c.threads);
+}
+
+Generation_threads::~Generation_threads () {
+	set_thread_limit(previous);
+}
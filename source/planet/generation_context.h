@@ -0,0 +1,67 @@
+#ifndef generation_context_h
+#define generation_context_h
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <ostream>
+
+class Generation_stage {
+public:
+	Generation_stage (const std::string& n, double s) :
+		name (n), seconds (s) {}
+
+	std::string name;
+	double seconds;
+};
+
+// everything a generation uses besides the planet and its parameters, so any number of
+// planets can be generated at once in one process, each with its own context.
+// random numbers come from counter_rng streams keyed by the seed and carry no state
+class Generation_context {
+public:
+	Generation_context () :
+		log (nullptr), threads (0), cancel (nullptr) {}
+
+	// progress messages, nullptr for none
+	std::ostream* log;
+	// threads for the loops of this generation, 0 for every core. 1 runs it serially,
+	// which gives the most throughput when generating one planet per core
+	int threads;
+	// generation stops after the current stage once this is set, leaving the planet incomplete.
+	// the longest loops also check it between blocks
+	const std::atomic<bool>* cancel;
+	// called from the generating thread with the stage and the fraction of it done, when a stage
+	// begins and between blocks of the longest loops, empty for none
+	std::function<void (const std::string&, double)> progress;
+	// seconds spent in each stage, in order
+	std::vector<Generation_stage> stages;
+
+	std::string stage;
+	std::chrono::steady_clock::time_point stage_start;
+};
+
+bool cancelled (const Generation_context&);
+void report_progress (const Generation_context&, double);
+// ends the current stage, if any, and starts timing the next
+void begin_stage (Generation_context&, const std::string&);
+// as begin_stage, but ends the current stage and returns false without starting the next once cancelled
+bool next_stage (Generation_context&, const std::string&);
+void end_stage (Generation_context&);
+double total_seconds (const Generation_context&);
+
+// context used by the generation functions that take none, logging to standard output
+Generation_context console_context ();
+
+// sets the thread limit of the context for loops started by this thread while it is in scope
+class Generation_threads {
+public:
+	Generation_threads (const Generation_context&);
+	~Generation_threads ();
+
+	int previous;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "grid.h"
 #include "../planet.h"
+#include "grid_cache.h"
 
 Grid::Grid (int s) :
 	size (s) {
@@ -12,8 +13,7 @@ Grid::Grid (int s) :
 }
 
 void set_grid_size (Planet& p, int size) {
-	delete p.grid;
-	p.grid = size_n_grid(size);
+	p.grid.reset(cached_grid(size));
 }
 
 const std::deque<Tile>& tiles (const Planet& p) {return p.grid->tiles;}
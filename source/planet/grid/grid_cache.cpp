@@ -0,0 +1,60 @@
+#include "grid_cache.h"
+#include "grid.h"
+#include "create_grid.h"
+#include "../../io/planet_file.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#define GRID_CACHE_MKDIR
+#endif
+
+std::string& _directory () {
+	static std::string directory = std::getenv("EARTHGEN_GRID_CACHE") ? std::getenv("EARTHGEN_GRID_CACHE") : "";
+	return directory;
+}
+
+const std::string& grid_cache_directory () {
+	return _directory();
+}
+
+void set_grid_cache_directory (const std::string& directory) {
+	_directory() = directory;
+}
+
+Grid* cached_grid (int size) {
+	// small grids are quicker to build than to read
+	if (grid_cache_directory().empty() || size < 4)
+		return size_n_grid(size);
+
+	std::string name = _grid_cache_file(size);
+	{
+		Planet_file f;
+		if (open_planet_file(f, name) && f.header->grid_size == size) {
+			Grid* g = load_grid(f);
+			if (g)
+				return g;
+		}
+	}
+
+	Grid* g = size_n_grid(size);
+#ifdef GRID_CACHE_MKDIR
+	mkdir(grid_cache_directory().c_str(), 0755);
+#endif
+	// written under a unique name and renamed, so concurrent generators never map a partial file
+	std::ostringstream temporary;
+	temporary << name << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "." << g << ".tmp";
+	if (save_grid(temporary.str(), *g))
+		std::rename(temporary.str().c_str(), name.c_str());
+	else
+		std::remove(temporary.str().c_str());
+	return g;
+}
+
+std::string _grid_cache_file (int size) {
+	std::ostringstream name;
+	name << grid_cache_directory() << "/grid_" << size << ".planet";
+	return name.str();
+}
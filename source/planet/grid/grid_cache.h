@@ -0,0 +1,17 @@
+#ifndef grid_cache_h
+#define grid_cache_h
+
+#include <string>
+class Grid;
+
+// directory holding one topology file per grid size, empty to disable the cache.
+// defaults to the EARTHGEN_GRID_CACHE environment variable
+const std::string& grid_cache_directory ();
+void set_grid_cache_directory (const std::string&);
+
+// grid of the given size, mapped from the cache when present, otherwise built and stored
+Grid* cached_grid (int size);
+
+std::string _grid_cache_file (int size);
+
+#endif
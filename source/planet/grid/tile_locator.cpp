@@ -0,0 +1,115 @@
+#include "tile_locator.h"
+#include "../planet.h"
+#include <algorithm>
+#include <cmath>
+
+void clear_locator (Tile_locator& l) {
+	l.resolution = 0;
+	std::vector<int>().swap(l.cells);
+}
+
+int _cell (const Tile_locator& l, const Vector3& v) {
+	float ax = std::abs(v.x);
+	float ay = std::abs(v.y);
+	float az = std::abs(v.z);
+	int face;
+	float major, a, b;
+	if (ax >= ay && ax >= az) {
+		face = v.x > 0 ? 0 : 1;
+		major = ax;
+		a = v.y;
+		b = v.z;
+	}
+	else if (ay >= az) {
+		face = v.y > 0 ? 2 : 3;
+		major = ay;
+		a = v.z;
+		b = v.x;
+	}
+	else {
+		face = v.z > 0 ? 4 : 5;
+		major = az;
+		a = v.x;
+		b = v.y;
+	}
+	if (major == 0)
+		return 0;
+	int n = l.resolution;
+	int i = std::min(n-1, (int)((a/major + 1.0f) * 0.5f * n));
+	int k = std::min(n-1, (int)((b/major + 1.0f) * 0.5f * n));
+	return (face*n + std::max(0, i))*n + std::max(0, k);
+}
+
+Vector3 _cell_centre (const Tile_locator& l, int face, int i, int k) {
+	int n = l.resolution;
+	float a = 2.0f * (i + 0.5f) / n - 1.0f;
+	float b = 2.0f * (k + 0.5f) / n - 1.0f;
+	float s = face % 2 == 0 ? 1.0f : -1.0f;
+	if (face < 2)
+		return normal(Vector3(s, a, b));
+	if (face < 4)
+		return normal(Vector3(b, s, a));
+	return normal(Vector3(a, b, s));
+}
+
+void init_locator (Tile_locator& l, const Planet& p) {
+	// roughly one tile per cell keeps the walks short
+	l.resolution = std::max(1, (int)std::sqrt(tile_count(p) / 6.0));
+	int n = l.resolution;
+	l.cells.resize(6*n*n);
+	const Tile* t = nth_tile(p, 0);
+	for (int face=0; face<6; face++)
+		for (int i=0; i<n; i++)
+			for (int k=0; k<n; k++) {
+				// neighbouring cells are close, so each walk starts from the previous result
+				int row_k = i%2 == 0 ? k : n-1-k;
+				Vector3 v = _cell_centre(l, face, i, row_k);
+				t = nearest_tile(v, t);
+				l.cells[_cell(l, v)] = id(t);
+			}
+}
+
+const Tile* find_tile (const Tile_locator& l, const Planet& p, const Vector3& v) {
+	return find_tile(p, v, nth_tile(p, l.cells[_cell(l, v)]));
+}
+
+const Tile* find_tile (const Planet&, const Vector3& v, const Tile* hint) {
+	const Tile* t = nearest_tile(v, hint);
+	if (contains(t, v))
+		return t;
+	// corners are not exactly equidistant from the tile centres, so near an edge the
+	// containing tile may be a neighbour of the closest one
+	for (const Tile* n : tiles(t))
+		if (contains(n, v))
+			return n;
+	return t;
+}
+
+bool contains (const Tile* t, const Vector3& v) {
+	for (int k=0; k<edge_count(t); k++) {
+		Vector3 side = cross_product(vector(nth_corner(t, k)), vector(nth_corner(t, k+1)));
+		if (dot_product(side, v) * dot_product(side, vector(t)) < 0)
+			return false;
+	}
+	return true;
+}
+
+const Tile* nearest_tile (const Vector3& v, const Tile* start) {
+	// greedy walk over neighbouring centres, which ends at the closest centre since
+	// tile adjacency is a delaunay triangulation of the centres
+	const Tile* t = start;
+	double closest = dot_product(vector(t), v);
+	while (true) {
+		const Tile* next = t;
+		for (const Tile* n : tiles(t)) {
+			double d = dot_product(vector(n), v);
+			if (d > closest) {
+				closest = d;
+				next = n;
+			}
+		}
+		if (next == t)
+			return t;
+		t = next;
+	}
+}
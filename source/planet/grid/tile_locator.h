@@ -0,0 +1,33 @@
+#ifndef tile_locator_h
+#define tile_locator_h
+
+#include <vector>
+#include "../../math/vector3.h"
+class Planet;
+class Tile;
+
+// cube map of starting tiles, a point is found by walking from the tile of its cell
+class Tile_locator {
+public:
+	Tile_locator () :
+		resolution (0) {}
+
+	// cells along the side of each cube face
+	int resolution;
+	std::vector<int> cells;
+};
+
+void clear_locator (Tile_locator&);
+void init_locator (Tile_locator&, const Planet&);
+
+// tile containing the point, in expected constant time
+const Tile* find_tile (const Tile_locator&, const Planet&, const Vector3&);
+// tile containing the point, found by walking from the hint towards it,
+// fast when successive points are close to each other
+const Tile* find_tile (const Planet&, const Vector3&, const Tile* hint);
+
+bool contains (const Tile*, const Vector3&);
+// tile whose centre is closest to the point, found by walking greedily from a starting tile
+const Tile* nearest_tile (const Vector3&, const Tile* start);
+
+#endif
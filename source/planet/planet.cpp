@@ -1,17 +1,8 @@
 #include "planet.h"
 #include "grid/grid.h"
 
-Planet::Planet () {
-	grid = size_n_grid(0);
-	terrain = new Terrain();
-	climate = new Climate();
-}
-
-Planet::~Planet () {
-	delete grid;
-	delete terrain;
-	delete climate;
-}
+Planet::Planet () :
+	grid (size_n_grid(0)), terrain (new Terrain()), climate (new Climate()) {}
 
 void clear (Planet& p) {
 	set_grid_size(p, 0);
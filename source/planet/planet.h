@@ -4,15 +4,15 @@
 #include "grid/grid.h"
 #include "terrain/terrain.h"
 #include "climate/climate.h"
+#include <memory>
 
 class Planet {
 public:
 	Planet ();
-	~Planet ();
 	
-	Grid* grid;
-	Terrain* terrain;
-	Climate* climate;
+	std::unique_ptr<Grid> grid;
+	std::unique_ptr<Terrain> terrain;
+	std::unique_ptr<Climate> climate;
 };
 
 void clear (Planet&);
@@ -0,0 +1,148 @@
+#include "planet_cache.h"
+#include "planet.h"
+#include "generation_context.h"
+#include "terrain/terrain_generation.h"
+#include "climate/climate_generation.h"
+#include "../io/planet_file.h"
+#include "../hash/md5.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#define PLANET_CACHE_MKDIR
+#endif
+
+std::string& _cache_directory () {
+	static std::string directory = std::getenv("EARTHGEN_CACHE") ? std::getenv("EARTHGEN_CACHE") : "";
+	return directory;
+}
+
+const std::string& planet_cache_directory () {
+	return _cache_directory();
+}
+
+void set_planet_cache_directory (const std::string& directory) {
+	_cache_directory() = directory;
+}
+
+std::string terrain_key (const Terrain_parameters& par) {
+	return md5(_key_text(par));
+}
+
+std::string climate_key (const Terrain_parameters& terrain, const Climate_parameters& climate) {
+	return md5(_key_text(terrain, climate));
+}
+
+void cached_terrain (Planet& p, const Terrain_parameters& par) {
+	Generation_context c = console_context();
+	cached_terrain(p, par, c);
+}
+
+bool cached_terrain (Planet& p, const Terrain_parameters& par, Generation_context& c) {
+	return cached_terrain(p, par, _elevation_vectors(par), c);
+}
+
+bool cached_terrain (Planet& p, const Terrain_parameters& par, const std::vector<std::array<Vector3, 3> >& elevation_vectors, Generation_context& c) {
+	if (planet_cache_directory().empty())
+		return generate_terrain(p, par, elevation_vectors, c);
+	std::string key = terrain_key(par);
+	Planet cached;
+	if (_load_cached(cached, key)) {
+		_swap_planet(p, cached);
+		return true;
+	}
+	if (!generate_terrain(p, par, elevation_vectors, c))
+		return false;
+	_store_cached(p, key);
+	return true;
+}
+
+void cached_climate (Planet& p, const Terrain_parameters& terrain, const Climate_parameters& climate) {
+	if (planet_cache_directory().empty()) {
+		generate_climate(p, climate);
+		return;
+	}
+	std::string key = climate_key(terrain, climate);
+	// only the climate is taken, grid and terrain of p may be referenced elsewhere
+	Planet cached;
+	if (_load_cached(cached, key) && tile_count(cached) == tile_count(p)) {
+		std::swap(p.climate, cached.climate);
+		m_terrain(p).var.axial_tilt = axial_tilt(cached);
+		return;
+	}
+	generate_climate(p, climate);
+	_store_cached(p, key);
+}
+
+void cached_planet (Planet& p, const Terrain_parameters& terrain, const Climate_parameters& climate) {
+	Planet cached;
+	if (!planet_cache_directory().empty() && _load_cached(cached, climate_key(terrain, climate))) {
+		_swap_planet(p, cached);
+		return;
+	}
+	cached_terrain(p, terrain);
+	cached_climate(p, terrain, climate);
+}
+
+std::string _key_prefix () {
+	std::ostringstream prefix;
+	prefix << "earthgen " << planet_cache_version << " " << Planet_file::version << " ";
+	return prefix.str();
+}
+
+// floating point values are written in hexadecimal so equal keys mean bit identical parameters
+std::string parameter_text (const Terrain_parameters& par) {
+	char values[256];
+	std::snprintf(values, sizeof(values), "%d %a %a %a %d %a",
+		par.grid_size, (double)par.axis.x, (double)par.axis.y, (double)par.axis.z, par.iterations, par.water_ratio);
+	std::ostringstream text;
+	text << "terrain " << values << " " << par.seed.size() << ":" << par.seed;
+	return text.str();
+}
+
+std::string parameter_text (const Terrain_parameters& terrain, const Climate_parameters& climate) {
+	char values[128];
+	std::snprintf(values, sizeof(values), "%d %a %a",
+		climate.seasons, climate.axial_tilt, (double)climate.error_tolerance);
+	return parameter_text(terrain) + " climate " + values;
+}
+
+std::string _key_text (const Terrain_parameters& par) {
+	return _key_prefix() + parameter_text(par);
+}
+
+std::string _key_text (const Terrain_parameters& terrain, const Climate_parameters& climate) {
+	return _key_prefix() + parameter_text(terrain, climate);
+}
+
+std::string _planet_cache_file (const std::string& key) {
+	return planet_cache_directory() + "/" + key + ".planet";
+}
+
+// callers load into a separate planet and swap, so a damaged entry leaves their planet untouched
+bool _load_cached (Planet& p, const std::string& key) {
+	return load_planet(p, _planet_cache_file(key));
+}
+
+void _swap_planet (Planet& a, Planet& b) {
+	std::swap(a.grid, b.grid);
+	std::swap(a.terrain, b.terrain);
+	std::swap(a.climate, b.climate);
+}
+
+void _store_cached (const Planet& p, const std::string& key) {
+	std::string name = _planet_cache_file(key);
+#ifdef PLANET_CACHE_MKDIR
+	mkdir(planet_cache_directory().c_str(), 0755);
+#endif
+	// written under a unique name and renamed, so concurrent generators never read a partial entry
+	std::ostringstream temporary;
+	temporary << name << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "." << &p << ".tmp";
+	if (save_planet(temporary.str(), p))
+		std::rename(temporary.str().c_str(), name.c_str());
+	else
+		std::remove(temporary.str().c_str());
+}
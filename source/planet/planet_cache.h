@@ -0,0 +1,47 @@
+#ifndef planet_cache_h
+#define planet_cache_h
+
+#include <string>
+#include <vector>
+#include <array>
+#include "../math/vector3.h"
+class Planet;
+class Terrain_parameters;
+class Climate_parameters;
+class Generation_context;
+
+// generated planets stored as planet files named by an md5 of every parameter that affects them.
+// empty to disable the cache, defaults to the EARTHGEN_CACHE environment variable
+const std::string& planet_cache_directory ();
+void set_planet_cache_directory (const std::string&);
+
+// increase whenever generation produces different planets for the same parameters,
+// so older entries are no longer found
+const int planet_cache_version = 2;
+
+std::string terrain_key (const Terrain_parameters&);
+// terrain parameters have to describe the planet the climate is generated for, including its current axis
+std::string climate_key (const Terrain_parameters&, const Climate_parameters&);
+
+// every parameter that affects a generated planet as text, without the versions in the keys
+std::string parameter_text (const Terrain_parameters&);
+std::string parameter_text (const Terrain_parameters&, const Climate_parameters&);
+
+// same as generate_terrain and generate_climate, read from the cache when present and stored otherwise
+void cached_terrain (Planet&, const Terrain_parameters&);
+// false if cancelled through the context, in which case nothing is stored
+bool cached_terrain (Planet&, const Terrain_parameters&, Generation_context&);
+bool cached_terrain (Planet&, const Terrain_parameters&, const std::vector<std::array<Vector3, 3> >& elevation_vectors, Generation_context&);
+void cached_climate (Planet&, const Terrain_parameters&, const Climate_parameters&);
+// terrain and climate, only reading the climate entry on a hit
+void cached_planet (Planet&, const Terrain_parameters&, const Climate_parameters&);
+
+std::string _key_prefix ();
+std::string _key_text (const Terrain_parameters&);
+std::string _key_text (const Terrain_parameters&, const Climate_parameters&);
+std::string _planet_cache_file (const std::string& key);
+bool _load_cached (Planet&, const std::string& key);
+void _store_cached (const Planet&, const std::string& key);
+void _swap_planet (Planet&, Planet&);
+
+#endif
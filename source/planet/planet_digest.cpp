@@ -0,0 +1,135 @@
+#include "planet_digest.h"
+#include "planet.h"
+#include "../math/counter_rng.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+void _add_array (std::vector<Planet_array>& arrays, const std::string& name, const std::string& stage, int count, const std::function<float (int)>& f) {
+	Planet_array a;
+	a.name = name;
+	a.stage = stage;
+	a.bits.resize(count);
+	for (int i=0; i<count; i++) {
+		float value = f(i);
+		std::memcpy(&a.bits[i], &value, sizeof(value));
+	}
+	arrays.push_back(std::move(a));
+}
+
+void _add_int_array (std::vector<Planet_array>& arrays, const std::string& name, const std::string& stage, int count, const std::function<int (int)>& f) {
+	Planet_array a;
+	a.name = name;
+	a.stage = stage;
+	a.floating = false;
+	a.bits.resize(count);
+	for (int i=0; i<count; i++)
+		a.bits[i] = (uint32_t)f(i);
+	arrays.push_back(std::move(a));
+}
+
+std::vector<Planet_array> planet_arrays (const Planet& p) {
+	std::vector<Planet_array> arrays;
+	_add_array(arrays, "tile_x", "terrain_grid", tile_count(p), [&](int i) {return vector(nth_tile(p, i)).x;});
+	_add_array(arrays, "tile_y", "terrain_grid", tile_count(p), [&](int i) {return vector(nth_tile(p, i)).y;});
+	_add_array(arrays, "tile_z", "terrain_grid", tile_count(p), [&](int i) {return vector(nth_tile(p, i)).z;});
+	_add_array(arrays, "corner_x", "terrain_grid", corner_count(p), [&](int i) {return vector(nth_corner(p, i)).x;});
+	_add_array(arrays, "corner_y", "terrain_grid", corner_count(p), [&](int i) {return vector(nth_corner(p, i)).y;});
+	_add_array(arrays, "corner_z", "terrain_grid", corner_count(p), [&](int i) {return vector(nth_corner(p, i)).z;});
+
+	const Terrain& t = terrain(p);
+	_add_array(arrays, "tile_elevation", "terrain_elevation", tile_count(p), [&](int i) {return elevation(nth_tile(t, i));});
+	_add_array(arrays, "corner_elevation", "terrain_elevation", corner_count(p), [&](int i) {return elevation(nth_corner(t, i));});
+	_add_array(arrays, "tile_water_surface", "terrain_sea", tile_count(p), [&](int i) {return nth_tile(t, i).water.surface;});
+	_add_array(arrays, "tile_water_depth", "terrain_sea", tile_count(p), [&](int i) {return water_depth(nth_tile(t, i));});
+	_add_int_array(arrays, "tile_type", "terrain_sea", tile_count(p), [&](int i) {return nth_tile(t, i).type;});
+	_add_int_array(arrays, "corner_type", "terrain_sea", corner_count(p), [&](int i) {return nth_corner(t, i).type;});
+	_add_int_array(arrays, "edge_type", "terrain_sea", edge_count(p), [&](int i) {return nth_edge(t, i).type;});
+	_add_int_array(arrays, "corner_river_direction", "terrain_rivers", corner_count(p), [&](int i) {return river_direction(nth_corner(t, i));});
+	_add_int_array(arrays, "corner_distance_to_sea", "terrain_rivers", corner_count(p), [&](int i) {return distance_to_sea(nth_corner(t, i));});
+
+	for (unsigned n=0; n<climate(p).seasons.size(); n++) {
+		const Season& s = nth_season(p, n);
+		std::string prefix = "season_" + std::to_string(n) + "_";
+		_add_array(arrays, prefix + "tile_temperature", "season_temperature", tile_count(p), [&](int i) {return temperature(nth_tile(s, i));});
+		_add_array(arrays, prefix + "edge_wind_velocity", "season_wind", edge_count(p), [&](int i) {return wind_velocity(nth_edge(s, i));});
+		_add_array(arrays, prefix + "tile_humidity", "season_humidity", tile_count(p), [&](int i) {return humidity(nth_tile(s, i));});
+		_add_array(arrays, prefix + "tile_precipitation", "season_humidity", tile_count(p), [&](int i) {return precipitation(nth_tile(s, i));});
+	}
+	return arrays;
+}
+
+uint64_t hash_bits (const uint32_t* bits, int count) {
+	uint64_t h = mix64(count);
+	int i = 0;
+	// two values per step
+	for (; i+2 <= count; i+=2)
+		h = mix64(h ^ (bits[i] | (uint64_t)bits[i+1] << 32));
+	if (i < count)
+		h = mix64(h ^ bits[i]);
+	return h;
+}
+
+Array_digest array_digest (const Planet_array& a) {
+	Array_digest d;
+	d.name = a.name;
+	d.stage = a.stage;
+	d.count = a.bits.size();
+	d.hash = hash_bits(a.bits.data(), d.count);
+	for (int first=0; first<d.count; first+=digest_block_size)
+		d.blocks.push_back(hash_bits(&a.bits[first], std::min(digest_block_size, d.count - first)));
+	return d;
+}
+
+Array_difference compare_arrays (const Planet_array& reference, const Planet_array& a, double tolerance) {
+	Array_difference d;
+	d.name = reference.name;
+	d.stage = reference.stage;
+	d.count = reference.bits.size();
+	int count = std::min(reference.bits.size(), a.bits.size());
+	// values near zero are allowed the difference of a value at the floor
+	double floor = 0;
+	if (reference.floating && tolerance > 0) {
+		for (uint32_t bits : reference.bits) {
+			float r;
+			std::memcpy(&r, &bits, sizeof(r));
+			if (std::isfinite(r))
+				floor = std::max(floor, (double)std::fabs(r));
+		}
+		floor *= tolerance_floor;
+	}
+	for (int i=0; i<count; i++) {
+		if (reference.bits[i] == a.bits[i])
+			continue;
+		bool differs = true;
+		if (reference.floating) {
+			float r, v;
+			std::memcpy(&r, &reference.bits[i], sizeof(r));
+			std::memcpy(&v, &a.bits[i], sizeof(v));
+			double difference = std::fabs((double)v - r);
+			// a nan on either side is as far off as it gets
+			if (std::isnan(difference))
+				difference = HUGE_VAL;
+			d.largest = std::max(d.largest, difference);
+			if (tolerance > 0 && difference <= tolerance * std::max(floor, std::fabs((double)r)))
+				differs = false;
+		}
+		if (differs) {
+			d.differing++;
+			if (d.first.size() < 8)
+				d.first.push_back(i);
+		}
+	}
+	// values missing from either array differ
+	d.differing += std::max(reference.bits.size(), a.bits.size()) - count;
+	return d;
+}
+
+std::vector<int> differing_blocks (const Array_digest& reference, const Array_digest& d) {
+	std::vector<int> blocks;
+	for (unsigned i=0; i<reference.blocks.size(); i++)
+		if (reference.count != d.count || i >= d.blocks.size() || reference.blocks[i] != d.blocks[i])
+			blocks.push_back(i);
+	return blocks;
+}
@@ -0,0 +1,71 @@
+#ifndef planet_digest_h
+#define planet_digest_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+class Planet;
+
+// one per tile, corner or edge array of a generated planet as 32 bit values, floats by their bits
+class Planet_array {
+public:
+	Planet_array () :
+		floating (true) {}
+
+	// such as "tile_elevation" or "season_2_tile_humidity"
+	std::string name;
+	// generation stage that writes the array, such as "terrain_sea" or "season_humidity"
+	std::string stage;
+	bool floating;
+	std::vector<uint32_t> bits;
+};
+
+// grid vectors, every terrain array and every array of each season, in generation order
+std::vector<Planet_array> planet_arrays (const Planet&);
+
+// digests of an array as a whole and of each block of digest_block_size values,
+// so a changed digest can be narrowed to the blocks that changed
+const int digest_block_size = 1024;
+
+class Array_digest {
+public:
+	Array_digest () :
+		count (0), hash (0) {}
+
+	std::string name;
+	std::string stage;
+	int count;
+	uint64_t hash;
+	std::vector<uint64_t> blocks;
+};
+
+Array_digest array_digest (const Planet_array&);
+// chained splitmix64 over the values, seeded with the count
+uint64_t hash_bits (const uint32_t*, int count);
+
+// differing values between two arrays of the same name
+class Array_difference {
+public:
+	Array_difference () :
+		count (0), differing (0), largest (0) {}
+
+	std::string name;
+	std::string stage;
+	int count;
+	int differing;
+	// index of the first few differing values
+	std::vector<int> first;
+	// largest absolute difference of floating point arrays
+	double largest;
+};
+
+// fraction of the largest reference magnitude in an array below which values count as that magnitude
+const double tolerance_floor = 1e-3;
+
+// values differ if their bits do, or with a tolerance above 0, if floats differ by more than
+// tolerance times the reference magnitude, or times tolerance_floor of the array's largest magnitude if that is more
+Array_difference compare_arrays (const Planet_array& reference, const Planet_array&, double tolerance);
+// indices of the blocks whose digests differ, all blocks if the counts differ
+std::vector<int> differing_blocks (const Array_digest& reference, const Array_digest&);
+
+#endif
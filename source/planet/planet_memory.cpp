@@ -0,0 +1,183 @@
+#include "planet_memory.h"
+#include "grid/grid.h"
+#include "terrain/terrain.h"
+#include "climate/season.h"
+#include "climate/climate_generation_season.h"
+#include "../render/colour.h"
+#include "../render/hammer_tile.h"
+#include "../render/planet_colours.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// glibc malloc: 16 byte aligned chunks with an 8 byte header, 32 bytes at least,
+// and blocks past the mmap threshold in whole pages
+double _heap_block (double bytes) {
+	if (bytes >= 128*1024)
+		return 4096 * std::ceil((bytes + 16) / 4096);
+	return std::max(32.0, 16 * std::floor((bytes + 8 + 15) / 16));
+}
+
+// libstdc++ deques allocate nodes of 512 bytes or one element, and a map of at least 8 node pointers
+double _deque_bytes (double count, double element_size) {
+	double per_node = element_size < 512 ? std::floor(512 / element_size) : 1;
+	double nodes = std::floor(count / per_node) + 1;
+	return nodes * _heap_block(per_node * element_size) + _heap_block(8 * std::max(8.0, nodes + 2));
+}
+
+double _vector_bytes (double count, double element_size) {
+	return count > 0 ? _heap_block(count * element_size) : 0;
+}
+
+double _grid_bytes (int size) {
+	double tiles = tile_count(size);
+	// every tile has a vector of neighbours, corners and edges, 12 of them pentagons
+	double tile_vectors = 12 * 3 * _vector_bytes(5, sizeof(void*)) + (tiles - 12) * 3 * _vector_bytes(6, sizeof(void*));
+	return _deque_bytes(tiles, sizeof(Tile)) + tile_vectors
+		+ _deque_bytes(corner_count(size), sizeof(Corner))
+		+ _deque_bytes(edge_count(size), sizeof(Edge));
+}
+
+double _season_values (int size) {
+	return 5.0 * tile_count(size) + corner_count(size) + 2.0 * edge_count(size);
+}
+
+double season_bytes (int size) {
+	return _deque_bytes(tile_count(size), sizeof(Climate_tile))
+		+ _deque_bytes(corner_count(size), sizeof(Climate_corner))
+		+ _deque_bytes(edge_count(size), sizeof(Climate_edge));
+}
+
+double _terrain_generation_bytes (int size, int iterations) {
+	double tiles = tile_count(size);
+	double vectors = _vector_bytes(std::max(0, iterations), sizeof(std::array<Vector3, 3>));
+	// the sea fill keeps a set of water tiles and a multimap of coast tiles, the river
+	// directions a multimap of corners, each node a 48 byte block
+	double sea = tiles * 48 + tiles * 48 + _vector_bytes(tiles / 8, 1);
+	double rivers = corner_count(size) * 48.0;
+	return std::max(vectors, std::max(sea, rivers));
+}
+
+double _season_generation_bytes (int size) {
+	double tiles = tile_count(size);
+	// the working season, humidity and precipitation of the previous sweep, and the season handed out
+	return _deque_bytes(tiles, sizeof(Climate_generation_tile))
+		+ _deque_bytes(corner_count(size), sizeof(Climate_generation_corner))
+		+ _deque_bytes(edge_count(size), sizeof(Climate_generation_edge))
+		+ 2 * _deque_bytes(tiles, sizeof(float))
+		+ season_bytes(size);
+}
+
+double _render_bytes (int size, int seasons) {
+	double tiles = tile_count(size);
+	double corners = corner_count(size);
+	// tile colours, topography and four palette coordinates of each cached season, map tiles,
+	// and the rotated vertices and their latitudes and longitudes create_geometry works on
+	int cached = std::min(seasons, cached_season_attributes);
+	return _deque_bytes(tiles, sizeof(Colour))
+		+ (1 + 4 * cached) * _vector_bytes(tiles, sizeof(float))
+		+ _vector_bytes(tiles, sizeof(Hammer_tile))
+		+ 3 * _vector_bytes(tiles, sizeof(float)) + 3 * _vector_bytes(corners, sizeof(float));
+}
+
+Memory_estimate estimate_memory (int grid_size, int iterations, int seasons, int storage) {
+	Memory_estimate m;
+	seasons = std::max(0, seasons);
+	m.grid = _grid_bytes(grid_size);
+	m.terrain = _deque_bytes(tile_count(grid_size), sizeof(Terrain_tile))
+		+ _deque_bytes(corner_count(grid_size), sizeof(Terrain_corner))
+		+ _deque_bytes(edge_count(grid_size), sizeof(Terrain_edge));
+
+	double values = _season_values(grid_size) * sizeof(int32_t);
+	if (storage == Memory_estimate::seasons_raw)
+		m.seasons = seasons * season_bytes(grid_size);
+	else if (storage == Memory_estimate::seasons_compressed) {
+		// compressed seasons, empty placeholders for the others, one decoded season,
+		// and the quantized keyframe kept for appending plus the decoder's key and values
+		m.seasons = seasons * (_vector_bytes(compressed_season_ratio * values, 1) + season_bytes(0))
+			+ season_bytes(grid_size) + 3 * _vector_bytes(values, 1);
+	}
+
+	// subdividing a grid keeps the previous size until the new one is built
+	double grid_generation = grid_size > 0 ? _grid_bytes(grid_size - 1) : 0;
+	double season_generation = seasons > 0 ? _season_generation_bytes(grid_size) : 0;
+	// encoding a season needs its quantized values and residuals
+	if (storage == Memory_estimate::seasons_compressed && seasons > 0)
+		season_generation += 2 * _vector_bytes(values, 1);
+	m.generation = std::max(grid_generation, std::max(_terrain_generation_bytes(grid_size, iterations), season_generation));
+	m.render = _render_bytes(grid_size, storage == Memory_estimate::seasons_streamed ? 0 : seasons);
+	return m;
+}
+
+double peak_bytes (const Memory_estimate& m) {
+	// generation buffers are freed before anything is coloured or projected
+	return m.grid + m.terrain + m.seasons + std::max(m.generation, m.render);
+}
+
+double& _memory_budget () {
+	static double budget = std::getenv("EARTHGEN_MEMORY_BUDGET") ? std::atof(std::getenv("EARTHGEN_MEMORY_BUDGET")) * 1024 * 1024 : 0;
+	return budget;
+}
+
+double memory_budget () {
+	return _memory_budget();
+}
+
+void set_memory_budget (double bytes) {
+	_memory_budget() = std::max(0.0, bytes);
+}
+
+bool within_memory_budget (const Memory_estimate& m) {
+	return memory_budget() <= 0 || peak_bytes(m) <= memory_budget();
+}
+
+int fitting_season_storage (int grid_size, int iterations, int seasons, int preferred) {
+	for (int storage=preferred; storage<=Memory_estimate::seasons_streamed; storage++)
+		if (within_memory_budget(estimate_memory(grid_size, iterations, seasons, storage)))
+			return storage;
+	return -1;
+}
+
+// a field of /proc/self/status in kilobytes, 0 when missing
+size_t _status_bytes (const char* field) {
+	size_t bytes = 0;
+#ifdef __linux__
+	FILE* f = std::fopen("/proc/self/status", "r");
+	if (!f)
+		return 0;
+	char line[256];
+	size_t length = std::strlen(field);
+	while (std::fgets(line, sizeof(line), f)) {
+		if (std::strncmp(line, field, length) == 0 && line[length] == ':') {
+			bytes = std::strtoull(line + length + 1, nullptr, 10) * 1024;
+			break;
+		}
+	}
+	std::fclose(f);
+#endif
+	return bytes;
+}
+
+size_t resident_bytes () {
+	return _status_bytes("VmRSS");
+}
+
+size_t peak_resident_bytes () {
+	return _status_bytes("VmHWM");
+}
+
+bool reset_peak_resident () {
+#ifdef __linux__
+	FILE* f = std::fopen("/proc/self/clear_refs", "w");
+	if (!f)
+		return false;
+	bool written = std::fputs("5", f) >= 0;
+	return std::fclose(f) == 0 && written;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,49 @@
+#ifndef planet_memory_h
+#define planet_memory_h
+
+#include <cstddef>
+
+// predicted bytes of a planet, from the element counts of its grid size and the sizes of the
+// classes holding them, including the allocator's per block overhead
+class Memory_estimate {
+public:
+	Memory_estimate () :
+		grid (0), terrain (0), seasons (0), generation (0), render (0) {}
+
+	// held once generation is done
+	double grid;
+	double terrain;
+	double seasons;
+	// transient, the largest of terrain generation and one season being generated
+	double generation;
+	// colours, map geometry, and the palette coordinates of the seasons colours keep
+	double render;
+
+	// how seasons are kept: all of them, compressed with season_codec with one decoded,
+	// or only the one being generated, as when streaming them to a file
+	enum {seasons_raw, seasons_compressed, seasons_streamed};
+};
+
+Memory_estimate estimate_memory (int grid_size, int iterations, int seasons, int storage);
+double peak_bytes (const Memory_estimate&);
+// bytes of one uncompressed season, and the share of its values' size a compressed season takes at most
+double season_bytes (int grid_size);
+const double compressed_season_ratio = 0.3;
+
+// bytes, 0 for no limit, defaults to the EARTHGEN_MEMORY_BUDGET environment variable in megabytes
+double memory_budget ();
+void set_memory_budget (double);
+bool within_memory_budget (const Memory_estimate&);
+// the preferred storage if it fits the budget, else the first more compact one that does, -1 if none
+int fitting_season_storage (int grid_size, int iterations, int seasons, int preferred);
+
+// resident set size of the process and its peak, 0 where the platform doesn't report them
+size_t resident_bytes ();
+size_t peak_resident_bytes ();
+// restarts the peak from the current resident size, false where that isn't possible
+bool reset_peak_resident ();
+
+double _heap_block (double bytes);
+double _deque_bytes (double count, double element_size);
+
+#endif
@@ -1,23 +1,48 @@
 #include "terrain_generation.h"
 #include "../planet.h"
+#include "../generation_context.h"
 #include <cmath>
+#include <algorithm>
 #include <cstdlib>
 #include <map>
 #include <set>
 #include <utility>
 #include "../../math/math_common.h"
+#include "../../math/counter_rng.h"
 #include "../../hash/md5.h"
+#include "../../thread/parallel.h"
 
 #include <iostream>
 void generate_terrain (Planet& p, const Terrain_parameters& par) {
+	Generation_context c = console_context();
+	generate_terrain(p, par, c);
+}
+
+bool generate_terrain (Planet& p, const Terrain_parameters& par, Generation_context& c) {
+	return generate_terrain(p, par, _elevation_vectors(par), c);
+}
+
+bool generate_terrain (Planet& p, const Terrain_parameters& par, const std::vector<std::array<Vector3, 3> >& elevation_vectors, Generation_context& c) {
+	Generation_threads threads(c);
+	if (!next_stage(c, "grid"))
+		return false;
 	clear(p);
 	set_grid_size(p, par.grid_size);
 	init_terrain(p);
 	_set_variables(p, par);
-	_set_elevation(p, par);
+	if (!next_stage(c, "elevation") || !_set_elevation(p, par, elevation_vectors, c)) {
+		end_stage(c);
+		return false;
+	}
+	if (!next_stage(c, "sea"))
+		return false;
 	_create_sea(p, par);
 	_classify_terrain(p);
+	if (!next_stage(c, "rivers"))
+		return false;
 	_set_river_directions(p);
+	end_stage(c);
+	return true;
 }
 
 void _set_variables (Planet& p, const Terrain_parameters& par) {
@@ -25,14 +50,25 @@ void _set_variables (Planet& p, const Terrain_parameters& par) {
 	m_terrain(p).var.radius = 40000000;
 }
 
-void _set_elevation (Planet& p, const Terrain_parameters& par) {
-	// can be made concurrent
-	auto d = _elevation_vectors(par);
-	for (auto& t : tiles(p))
-		m_tile(m_terrain(p), id(t)).elevation = _elevation_at_point(t.v, d);
-	for (auto& c : corners(p))
-		m_corner(m_terrain(p), id(c)).elevation = _elevation_at_point(c.v, d);
+bool _set_elevation (Planet& p, const Terrain_parameters& par, const std::vector<std::array<Vector3, 3> >& d, const Generation_context& c) {
+	// tiles followed by corners, a block at a time so progress can be reported and cancellation noticed
+	int tiles = tile_count(p);
+	int points = tiles + corner_count(p);
+	for (int block=0; block<points; block+=elevation_block_size) {
+		if (cancelled(c))
+			return false;
+		report_progress(c, (double)block / points);
+		parallel_for(block, std::min(points, block+elevation_block_size), [&](int first, int last) {
+			for (int i=first; i<last; i++) {
+				if (i < tiles)
+					m_tile(m_terrain(p), i).elevation = _elevation_at_point(vector(nth_tile(p, i)), d);
+				else
+					m_corner(m_terrain(p), i-tiles).elevation = _elevation_at_point(vector(nth_corner(p, i-tiles)), d);
+			}
+		});
+	}
 	_scale_elevation(p, par);
+	return true;
 }
 
 void _scale_elevation (Planet& p, const Terrain_parameters&) {
@@ -193,28 +229,17 @@ void _set_river_directions (Planet& p) {
 	}
 }
 
-unsigned int hex_string_to_uint (std::string s) {
-	unsigned int n = 0;
-	for (unsigned int i=0; i<s.length(); i++) {
-		n *= 16;
-		n += s[i];
-		if (s[i] >= 'a') n += 10 - 'a';
-		else if (s[i] >= 'A') n += 10 - 'A';
-		else n -= '0';
-	}
-	return n;
-}
-
 std::vector<std::array<Vector3, 3> > _elevation_vectors (const Terrain_parameters& par) {
-	srand(hex_string_to_uint(md5(par.seed)));
-	std::vector<std::array<Vector3, 3> > d;
-	for (int i=0; i<par.iterations; i++) {
-		std::array<Vector3, 3> v = {{
-			point_uniform(rand(), rand()),
-			point_uniform(rand(), rand()),
-			point_uniform(rand(), rand())}};
-		d.push_back(v);
-	}
+	// every vector has its own substream, so the result doesn't depend on the order or thread they are made in
+	Counter_rng stage = substream(hex_rng(md5(par.seed)), elevation_vector_stream);
+	std::vector<std::array<Vector3, 3> > d(std::max(0, par.iterations));
+	parallel_for(0, d.size(), [&](int first, int last) {
+		for (int i=first; i<last; i++) {
+			Counter_rng r = substream(stage, i);
+			for (int k=0; k<3; k++)
+				d[i][k] = point_uniform(random_unit(r, 2*k), random_unit(r, 2*k+1));
+		}
+	});
 	return d;
 }
 
@@ -231,8 +256,8 @@ float _elevation_at_point (const Vector3& point, const std::vector<std::array<Ve
 	return elevation;
 }
 
-Vector3 point_uniform (int a, int b) {
-	double x = 2*pi*(a/(double)RAND_MAX);
-	double y = acos(2*(b/(double)RAND_MAX)-1)-(0.5*pi);
+Vector3 point_uniform (double a, double b) {
+	double x = 2*pi*a;
+	double y = acos(2*b-1)-(0.5*pi);
 	return Vector3(sin(x)*cos(y), sin(y), cos(x)*cos(y));
 }
@@ -6,16 +6,27 @@
 #include "../../math/vector3.h"
 #include "terrain_parameters.h"
 class Planet;
+class Generation_context;
 class Tile;
 class Corner;
 class Edge;
 
 void generate_terrain (Planet&, const Terrain_parameters&);
+// false if cancelled through the context, leaving the terrain incomplete
+bool generate_terrain (Planet&, const Terrain_parameters&, Generation_context&);
+// as above, with the elevation vectors of the parameters made beforehand. elevation at a point
+// doesn't depend on the grid, so planets of any size can share them, such as a coarse preview
+bool generate_terrain (Planet&, const Terrain_parameters&, const std::vector<std::array<Vector3, 3> >& elevation_vectors, Generation_context&);
 
 void _set_variables (Planet&, const Terrain_parameters&);
-void _set_elevation (Planet&, const Terrain_parameters&);
+// false if cancelled through the context
+bool _set_elevation (Planet&, const Terrain_parameters&, const std::vector<std::array<Vector3, 3> >&, const Generation_context&);
+// points whose elevation is set between checks for cancellation
+const int elevation_block_size = 16384;
 void _scale_elevation (Planet&, const Terrain_parameters&);
 void _create_sea (Planet&, const Terrain_parameters&);
+// random streams of the generation stages, substreams of the seed
+enum {elevation_vector_stream = 1};
 std::vector<std::array<Vector3, 3> > _elevation_vectors (const Terrain_parameters&);
 
 int _tile_type (const Planet&, const Tile*);
@@ -26,7 +37,7 @@ void _set_river_directions (Planet&);
 
 float _elevation_at_point (const Vector3&, const std::vector<std::array<Vector3, 3> >&);
 
-//returns point on sphere of uniform distribution, given two random integers
-Vector3 point_uniform (int, int);
+//returns point on sphere of uniform distribution, given two random numbers in [0, 1)
+Vector3 point_uniform (double, double);
 
 #endif
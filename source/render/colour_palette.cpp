@@ -0,0 +1,46 @@
+#include "colour_palette.h"
+#include <algorithm>
+#include <cmath>
+
+int add_ramp (Colour_palette& p, Colour (*f)(double), double low, double high, int texels) {
+	Palette_ramp r;
+	r.first = p.texels.size();
+	r.count = texels;
+	r.low = low;
+	r.high = high;
+	for (int i=0; i<texels; i++) {
+		double d = texels > 1 ? (double)i/(texels-1) : 0.0;
+		p.texels.push_back(f(low + d*(high-low)));
+	}
+	p.ramps.push_back(r);
+	return p.ramps.size() - 1;
+}
+
+int add_ramp (Colour_palette& p, const Colour& c) {
+	Palette_ramp r;
+	r.first = p.texels.size();
+	r.count = 1;
+	p.texels.push_back(c);
+	p.ramps.push_back(r);
+	return p.ramps.size() - 1;
+}
+
+float coordinate (const Colour_palette& p, int ramp, double value) {
+	const Palette_ramp& r = p.ramps[ramp];
+	double d = 0.0;
+	if (r.count > 1 && r.high != r.low) {
+		d = (value - r.low) / (r.high - r.low);
+		d = std::max(0.0, std::min(1.0, d));
+	}
+	return (r.first + 0.5 + d*(r.count-1)) / p.texels.size();
+}
+
+Colour colour (const Colour_palette& p, float coordinate) {
+	int size = p.texels.size();
+	double x = coordinate * size - 0.5;
+	x = std::max(0.0, std::min((double)size-1, x));
+	int i = std::min(size-2, (int)std::floor(x));
+	if (i < 0)
+		return p.texels[0];
+	return interpolate(p.texels[i], p.texels[i+1], x-i);
+}
@@ -0,0 +1,38 @@
+#ifndef colour_palette_h
+#define colour_palette_h
+
+#include <vector>
+#include "colour.h"
+
+// a range of texels covering values from low to high
+class Palette_ramp {
+public:
+	Palette_ramp () :
+		first (0), count (0), low (0), high (0) {}
+
+	int first;
+	int count;
+	double low;
+	double high;
+};
+
+// lookup table uploaded as a 1d texture, tiles reference it by texture coordinate
+class Colour_palette {
+public:
+	Colour_palette () {}
+
+	std::vector<Colour> texels;
+	std::vector<Palette_ramp> ramps;
+};
+
+// samples a colour function over [low, high] into a new ramp, returns ramp index
+int add_ramp (Colour_palette&, Colour (*)(double), double low, double high, int texels);
+// single texel ramp of constant colour
+int add_ramp (Colour_palette&, const Colour&);
+
+// texture coordinate of a value on a ramp, clamped to the ramp's range
+float coordinate (const Colour_palette&, int ramp, double value);
+// colour at texture coordinate, interpolated the same way as linear texture filtering
+Colour colour (const Colour_palette&, float coordinate);
+
+#endif
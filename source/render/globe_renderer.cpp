@@ -5,11 +5,13 @@
 #include "../math/quaternion.h"
 #include "../planet/planet.h"
 #include "planet_colours.h"
+#include "grid_vectors.h"
 #include <iostream>
 
 Globe_renderer::Globe_renderer () : Planet_renderer () {
 	reset_rotation();
 	show_rivers = false;
+	grid_size = -1;
 }
 
 void Globe_renderer::set_matrix () {
@@ -19,28 +21,64 @@ void Globe_renderer::set_matrix () {
 	glOrtho(-x, x, -y, y, -2.0, 0.0);
 }	
 
-void Globe_renderer::draw_tile (const Tile* t, const Matrix3& m, const Colour& colour) {
-	glColor3f(colour);
+void Globe_renderer::transform_vertices (const Planet& planet, const Matrix3& m) {
+	// grids are the same for every planet of a size
+	if (grid_size != planet.grid->size || size(tile_positions) != tile_count(planet)) {
+		tile_vectors(tile_positions, planet);
+		corner_vectors(corner_positions, planet);
+		grid_size = planet.grid->size;
+	}
+	_rotate_vertices(pool, m, tile_positions, tile_vertices);
+	_rotate_vertices(pool, m, corner_positions, corner_vertices);
+}
+
+void _rotate_vertices (std::unique_ptr<Thread_pool>& pool, const Matrix3& m, const Vector3_array& in, Vector3_array& out) {
+	int count = size(in);
+	resize(out, count);
+	if (count < parallel_rotation_size) {
+		transform(m, in, out);
+		return;
+	}
+	if (!pool)
+		pool.reset(new Thread_pool());
+	int blocks = worker_count(*pool);
+	for (int i=0; i<blocks; i++) {
+		int first = (long long)count * i / blocks;
+		int last = (long long)count * (i+1) / blocks;
+		submit(*pool, [&m, &in, &out, first, last] () {transform(m, in, out, first, last);});
+	}
+	wait(*pool);
+}
+
+void Globe_renderer::draw_tile (const Tile* t) {
 	glBegin(GL_TRIANGLE_FAN);
-	glVertex3f(m*vector(t));
+	glVertex3f(get(tile_vertices, id(t)));
 	for (const Corner* c : corners(t))
-		glVertex3f(m*vector(c));
-	glVertex3f(m*vector(corners(t)[0]));
+		glVertex3f(get(corner_vertices, id(c)));
+	glVertex3f(get(corner_vertices, id(corners(t)[0])));
 	glEnd();
+	count_primitive(statistics, edge_count(t) + 2);
 }
 
-void Globe_renderer::draw_river (const Tile* t, int edge, const Matrix3& m, const Colour& colour) {
+void Globe_renderer::draw_river (const Tile* t, int edge, const Colour& colour) {
+	// rotation is linear, so points between rotated corners are the rotated points between corners
+	Vector3 previous = get(corner_vertices, id(nth_corner(t, edge-1)));
+	Vector3 a = get(corner_vertices, id(nth_corner(t, edge)));
+	Vector3 b = get(corner_vertices, id(nth_corner(t, edge+1)));
+	Vector3 next = get(corner_vertices, id(nth_corner(t, edge+2)));
 	glColor3f(colour);
 	glBegin(GL_TRIANGLE_FAN);
-	glVertex3f(m*(vector(nth_corner(t, edge)) + (vector(nth_corner(t, edge-1)) - vector(nth_corner(t, edge)))*0.1));
-	glVertex3f(m*vector(nth_corner(t, edge)));
-	glVertex3f(m*vector(nth_corner(t, edge+1)));
+	glVertex3f(a + (previous - a)*0.1);
+	glVertex3f(a);
+	glVertex3f(b);
 	glEnd();
 	glBegin(GL_TRIANGLES);
-	glVertex3f(m*vector(nth_corner(t, edge+1)));
-	glVertex3f(m*(vector(nth_corner(t, edge+1)) + (vector(nth_corner(t, edge+2)) - vector(nth_corner(t, edge+1)))*0.1));
-	glVertex3f(m*(vector(nth_corner(t, edge)) + (vector(nth_corner(t, edge-1)) - vector(nth_corner(t, edge)))*0.1));
+	glVertex3f(b);
+	glVertex3f(b + (next - b)*0.1);
+	glVertex3f(a + (previous - a)*0.1);
 	glEnd();
+	count_primitive(statistics, 3);
+	count_primitive(statistics, 3);
 
 	/*
 	glColor3f(colour);
@@ -56,10 +94,13 @@ void Globe_renderer::draw (const Planet& planet, const Quaternion& q, const Plan
 	set_matrix();
 	glFrontFace(GL_CCW);
 	glEnable(GL_CULL_FACE);
-	Matrix3 m = matrix3(rotation()*q);
+	transform_vertices(planet, matrix3(rotation()*q));
+	bind_colours(colours);
 	for (auto& t : tiles(planet)) {
-		draw_tile(&t, m, colours.tiles[id(t)]);
+		set_tile_colour(colours, id(t));
+		draw_tile(&t);
 	}
+	unbind_colours();
 
 	if (show_rivers)
 		for (auto& t : tiles(planet))
@@ -69,7 +110,7 @@ void Globe_renderer::draw (const Planet& planet, const Quaternion& q, const Plan
 					if (has_river(planet, e)) {
 						River r = river(planet, e);
 						if (left_tributary(planet, r) || right_tributary(planet, r))
-							draw_river(&t, k, m, Colour(0.04, 0.14, 0.72));
+							draw_river(&t, k, Colour(0.04, 0.14, 0.72));
 					}
 				}
 			}
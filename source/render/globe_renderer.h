@@ -3,18 +3,26 @@
 
 #include "planet_renderer.h"
 #include "../math/quaternion.h"
+#include "../math/batch_math.h"
+#include "../thread/thread_pool.h"
+#include <memory>
 class Vector2;
 class Matrix3;
 class Tile;
 class Planet;
 
+// vertices are rotated on the render thread below this count, and split across a pool above it
+const int parallel_rotation_size = 1 << 17;
+
 class Globe_renderer : public Planet_renderer {
 public:
 	Globe_renderer ();
 
 	void set_matrix ();
-	void draw_tile (const Tile*, const Matrix3&, const Colour&);
-	void draw_river (const Tile*, int, const Matrix3&, const Colour&);
+	// rotates every tile centre and corner once, drawing reads the results
+	void transform_vertices (const Planet&, const Matrix3&);
+	void draw_tile (const Tile*);
+	void draw_river (const Tile*, int, const Colour&);
 	void draw (const Planet&, const Quaternion&, const Planet_colours&);
 	void change_scale (const Vector2&, double);
 	void mouse_dragged (const Vector2&);
@@ -28,6 +36,17 @@ public:
 	double latitude;
 	double longitude;
 	bool show_rivers;
+	// unrotated tile centres and corners of the grid of grid_size
+	int grid_size;
+	Vector3_array tile_positions;
+	Vector3_array corner_positions;
+	// positions of the current frame by tile and corner id, kept to reuse their storage
+	Vector3_array tile_vertices;
+	Vector3_array corner_vertices;
+	// started the first time a grid is large enough to rotate in parallel
+	std::unique_ptr<Thread_pool> pool;
 };
 
+void _rotate_vertices (std::unique_ptr<Thread_pool>&, const Matrix3&, const Vector3_array& in, Vector3_array& out);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include "grid_vectors.h"
+#include "../math/matrix3.h"
+#include "../planet/planet.h"
+#include "../thread/parallel.h"
+
+void tile_vectors (Vector3_array& a, const Planet& p) {
+	resize(a, tile_count(p));
+	parallel_for(0, tile_count(p), [&](int first, int last) {
+		for (int i=first; i<last; i++)
+			set(a, i, vector(nth_tile(p, i)));
+	});
+}
+
+void corner_vectors (Vector3_array& a, const Planet& p) {
+	resize(a, corner_count(p));
+	parallel_for(0, corner_count(p), [&](int first, int last) {
+		for (int i=first; i<last; i++)
+			set(a, i, vector(nth_corner(p, i)));
+	});
+}
+
+void rotated_tiles (Vector3_array& a, const Planet& p, const Matrix3& m) {
+	resize(a, tile_count(p));
+	parallel_for(0, tile_count(p), [&](int first, int last) {
+		for (int i=first; i<last; i++)
+			set(a, i, vector(nth_tile(p, i)));
+		transform(m, a, a, first, last);
+	});
+}
+
+void rotated_corners (Vector3_array& a, const Planet& p, const Matrix3& m) {
+	resize(a, corner_count(p));
+	parallel_for(0, corner_count(p), [&](int first, int last) {
+		for (int i=first; i<last; i++)
+			set(a, i, vector(nth_corner(p, i)));
+		transform(m, a, a, first, last);
+	});
+}
@@ -0,0 +1,17 @@
+#ifndef grid_vectors_h
+#define grid_vectors_h
+
+#include "../math/batch_math.h"
+class Matrix3;
+class Planet;
+
+// tile centres and corners of a planet's grid by id
+void tile_vectors (Vector3_array&, const Planet&);
+void corner_vectors (Vector3_array&, const Planet&);
+
+// the same rotated by a matrix, in batches. every corner is shared by three tiles,
+// so geometry built from these rotates each corner once rather than once per tile
+void rotated_tiles (Vector3_array&, const Planet&, const Matrix3&);
+void rotated_corners (Vector3_array&, const Planet&, const Matrix3&);
+
+#endif
@@ -1,21 +1,56 @@
 #include "hammer_projection.h"
+#include "grid_vectors.h"
 #include "../math/vector2.h"
 #include "../math/vector3.h"
 #include "../math/matrix3.h"
 #include "../math/quaternion.h"
+#include "../math/fast_math.h"
 #include "../planet/planet.h"
+#include "../thread/parallel.h"
 #include <cmath>
 
 void clear (Hammer_projection& proj) {
-	std::deque<Hammer_tile>().swap(proj.tiles);
+	std::vector<Hammer_tile>().swap(proj.tiles);
+	proj.grid_size = -1;
+	proj.tile_count = 0;
+}
+
+bool _same_rotation (const Quaternion& a, const Quaternion& b) {
+	return a.a == b.a && a.i == b.i && a.j == b.j && a.k == b.k;
 }
 
 void create_geometry (Hammer_projection& proj, const Planet& p, const Quaternion& q) {
-	clear(proj);
+	if (proj.grid_size == p.grid->size && proj.tile_count == tile_count(p) && _same_rotation(proj.rotation, q))
+		return;
+	proj.tiles.resize(tile_count(p));
 	Matrix3 m = matrix3(q);
-	for (auto& t : tiles(p)) {
-		proj.tiles.push_back(Hammer_tile(&t, m));
-	}
+	// corners are converted to latitude and longitude once each, in batches
+	Vector3_array tile_points, corner_points;
+	rotated_tiles(tile_points, p, m);
+	rotated_corners(corner_points, p, m);
+	// z is no longer needed, and becomes the latitude
+	parallel_for(0, tile_count(p), [&](int first, int last) {
+		fast_asin(&tile_points.z[first], &tile_points.z[first], last - first);
+		fast_atan2(&tile_points.y[first], &tile_points.x[first], &tile_points.x[first], last - first);
+	});
+	parallel_for(0, corner_count(p), [&](int first, int last) {
+		fast_asin(&corner_points.z[first], &corner_points.z[first], last - first);
+		fast_atan2(&corner_points.y[first], &corner_points.x[first], &corner_points.x[first], last - first);
+	});
+	parallel_for(0, tile_count(p), [&](int first, int last) {
+		for (int i=first; i<last; i++) {
+			const Tile* t = nth_tile(p, i);
+			float latitudes[6], longitudes[6];
+			for (int k=0; k<edge_count(t); k++) {
+				latitudes[k] = corner_points.z[id(nth_corner(t, k))];
+				longitudes[k] = corner_points.x[id(nth_corner(t, k))];
+			}
+			proj.tiles[i] = Hammer_tile(t, tile_points.z[i], tile_points.x[i], latitudes, longitudes);
+		}
+	});
+	proj.grid_size = p.grid->size;
+	proj.tile_count = tile_count(p);
+	proj.rotation = q;
 }
 
 Vector3 from_lat_long(double latitude, double longitude) {
@@ -34,6 +69,12 @@ Vector2 to_hammer (const Vector3& v) {
 Vector2 to_hammer (double latitude, double longitude) {
 	return Vector2(2.0*cos(latitude)*sin(longitude/2.0), sin(latitude)) * (sqrt(2.0)/sqrt(1.0+cos(latitude)*cos(longitude/2.0)));
 }
+Vector2 fast_to_hammer (float latitude, float longitude) {
+	float sin_latitude, cos_latitude, sin_half, cos_half;
+	fast_sincos(latitude, sin_latitude, cos_latitude);
+	fast_sincos(longitude/2, sin_half, cos_half);
+	return Vector2(2*cos_latitude*sin_half, sin_latitude) * (std::sqrt(2.0f)/std::sqrt(1+cos_latitude*cos_half));
+}
 
 double hammer_width () {return sqrt(8.0);}
 double hammer_height () {return sqrt(2.0);}
\ No newline at end of file
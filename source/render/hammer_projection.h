@@ -2,27 +2,35 @@
 #define hammer_projection_h
 
 #include "hammer_tile.h"
-#include <deque>
+#include "../math/quaternion.h"
+#include <vector>
 class Vector2;
 class Vector3;
-class Quaternion;
 class Planet;
 
 class Hammer_projection {
 public:
-	Hammer_projection () {}
+	Hammer_projection () :
+		grid_size (-1), tile_count (0) {}
 
-	std::deque<Hammer_tile> tiles;
+	std::vector<Hammer_tile> tiles;
+	// geometry only depends on the grid, which is the same for every grid of a size, and the rotation
+	int grid_size;
+	int tile_count;
+	Quaternion rotation;
 };
 
 void clear (Hammer_projection&);
+// does nothing if the projection was already created for the same grid size and rotation
 void create_geometry (Hammer_projection&, const Planet&, const Quaternion&);
 
 Vector3 from_hammer (const Vector2&);
 Vector2 to_hammer (const Vector3&);
 Vector2 to_hammer (double latitude, double longitude);
+// to_hammer with fast_math, positions within 1e-5 of it
+Vector2 fast_to_hammer (float latitude, float longitude);
 
 double hammer_width ();
 double hammer_height ();
 
-#endif
\ No newline at end of file
+#endif
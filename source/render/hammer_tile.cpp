@@ -1,16 +1,18 @@
 #include "hammer_tile.h"
 #include "hammer_projection.h"
 #include "../planet/planet.h"
-#include "../math/matrix3.h"
-#include "../math/quaternion.h"
+#include "../math/math_common.h"
 
-Hammer_tile::Hammer_tile (const Tile* t, const Matrix3& m) {
-	centre = to_hammer(m * vector(t));
-	double tile_longitude = longitude(m * vector(t));
-	Quaternion longitude_offset = Quaternion(Vector3(0,0,1), -longitude(m * vector(t)));
+Hammer_tile::Hammer_tile (const Tile* t, float tile_latitude, float tile_longitude, const float* corner_latitudes, const float* corner_longitudes) {
+	centre = fast_to_hammer(tile_latitude, tile_longitude);
 	for (int i=0; i < edge_count(t); i++) {
-		const Vector3 v = m * vector(t->corners[i]);
-		corners[i] = to_hammer(latitude(v), tile_longitude + longitude(longitude_offset * v));
+		// corners are placed on the same side of the map as the centre, past the edge if needed
+		float offset = corner_longitudes[i] - tile_longitude;
+		if (offset > pi)
+			offset -= 2*pi;
+		else if (offset <= -pi)
+			offset += 2*pi;
+		corners[i] = fast_to_hammer(corner_latitudes[i], tile_longitude + offset);
 	}
 	if (edge_count(t) == 5)
 		corners[5] = corners[0];
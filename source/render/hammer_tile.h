@@ -3,11 +3,12 @@
 
 #include "../math/vector2.h"
 class Tile;
-class Matrix3;
 
 class Hammer_tile {
 public:
-	Hammer_tile (const Tile*, const Matrix3&);
+	Hammer_tile () {}
+	// from latitudes and longitudes of the rotated centre and corners, projected with fast_to_hammer
+	Hammer_tile (const Tile*, float latitude, float longitude, const float* corner_latitudes, const float* corner_longitudes);
 	
 	Vector2 centre;
 	Vector2 corners[6];
@@ -0,0 +1,22 @@
+#include "image.h"
+#include <algorithm>
+
+unsigned char _channel (float c) {
+	return std::max(0, std::min(255, (int)(c*255.0f + 0.5f)));
+}
+
+void set_pixels (Image& image, int row, int first, int last, const Colour& c) {
+	unsigned char r = _channel(c.r);
+	unsigned char g = _channel(c.g);
+	unsigned char b = _channel(c.b);
+	unsigned char* p = &image.pixels[3*((size_t)row*image.width + first)];
+	for (int i=first; i<last; i++) {
+		*p++ = r;
+		*p++ = g;
+		*p++ = b;
+	}
+}
+
+const unsigned char* row (const Image& image, int n) {
+	return &image.pixels[3*(size_t)n*image.width];
+}
@@ -0,0 +1,24 @@
+#ifndef image_h
+#define image_h
+
+#include <cstddef>
+#include <vector>
+#include "colour.h"
+
+// 8 bit rgb framebuffer, rows from top to bottom
+class Image {
+public:
+	Image () :
+		width (0), height (0) {}
+	Image (int w, int h) :
+		width (w), height (h), pixels (3*(size_t)w*h, 0) {}
+
+	int width;
+	int height;
+	std::vector<unsigned char> pixels;
+};
+
+void set_pixels (Image&, int row, int first, int last, const Colour&);
+const unsigned char* row (const Image&, int);
+
+#endif
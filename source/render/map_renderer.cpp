@@ -1,10 +1,15 @@
 #include "map_renderer.h"
 #include "planet_colours.h"
+#include "software_renderer.h"
 #include "../planet/planet.h"
 #include "../math/quaternion.h"
+#include <algorithm>
 
 Map_renderer::Map_renderer () : Planet_renderer () {
 	geometry_updated = false;
+	tile_ids_updated = false;
+	tile_ids_width = 0;
+	tile_ids_height = 0;
 	scale = min_scale();
 }
 
@@ -15,14 +20,14 @@ void Map_renderer::set_matrix () {
 	glOrtho(bottom_left.x, top_right.x, bottom_left.y, top_right.y, -2.0, 0.0);
 }
 
-void Map_renderer::draw_tile (int i, const Colour& colour) {
-	glColor3f(colour);
+void Map_renderer::draw_tile (int i) {
 	glBegin(GL_TRIANGLE_FAN);
 	glVertex2f(projection.tiles[i].centre);
 	for (auto& c : projection.tiles[i].corners)
 		glVertex2f(c);
 	glVertex2f(projection.tiles[i].corners[0]);
 	glEnd();
+	count_primitive(statistics, 8);
 }
 
 void Map_renderer::draw (const Planet& planet, const Quaternion& q, const Planet_colours& colours) {
@@ -32,8 +37,12 @@ void Map_renderer::draw (const Planet& planet, const Quaternion& q, const Planet
 	}
 
 	set_matrix();
-	for (int i=0; i<tile_count(planet); i++)
-		draw_tile(i, colours.tiles[i]);
+	bind_colours(colours);
+	for (int i=0; i<tile_count(planet); i++) {
+		set_tile_colour(colours, i);
+		draw_tile(i);
+	}
+	unbind_colours();
 }
 
 void Map_renderer::change_scale (const Vector2& screen_position, double delta) {
@@ -51,11 +60,13 @@ void Map_renderer::change_scale (const Vector2& screen_position, double delta) {
 	camera_position = camera_position + screen_to_map_position(screen_position, new_scale) - screen_to_map_position(screen_position, scale);
 	scale = new_scale;
 	clamp_offset();
+	tile_ids_updated = false;
 }
 
 void Map_renderer::mouse_dragged (const Vector2& delta) {
 	camera_position = screen_to_map_position(delta + map_to_screen_position(camera_position, scale), scale);
 	clamp_offset();
+	tile_ids_updated = false;
 }
 
 Vector3 Map_renderer::to_coordinates (const Vector2& screen_position) const {
@@ -102,8 +113,35 @@ double Map_renderer::min_scale () const {
 }
 
 void Map_renderer::update_geometry () {
-	clear(projection);
+	// projection is kept, create_geometry only rebuilds it if the grid or axis changed
 	geometry_updated = false;
+	tile_ids_updated = false;
+}
+
+int Map_renderer::tile_at (const Vector2& screen_position) {
+	if (!geometry_updated)
+		return -1;
+	if (!tile_ids_updated || tile_ids_width != width || tile_ids_height != height)
+		update_tile_ids();
+	int x = screen_position.x;
+	int y = screen_position.y;
+	if (x < 0 || y < 0 || x >= width || y >= height)
+		return -1;
+	return tile_ids[y*width + x];
+}
+
+void Map_renderer::update_tile_ids () {
+	Vector2 bottom_left = screen_to_map_position(Vector2(0,height), scale) + map_offset();
+	Vector2 top_right = screen_to_map_position(Vector2(width, 0), scale) + map_offset();
+	Raster_geometry geometry;
+	map_geometry(geometry, projection, width, height, bottom_left, top_right);
+	tile_ids.assign(width*height, -1);
+	scan_geometry(geometry, [&](int tile, int row, int first, int last) {
+		std::fill(tile_ids.begin() + row*width + first, tile_ids.begin() + row*width + last, tile);
+	});
+	tile_ids_width = width;
+	tile_ids_height = height;
+	tile_ids_updated = true;
 }
 
 Vector2 Map_renderer::screen_to_map_position (const Vector2& screen_position, double scale) const {
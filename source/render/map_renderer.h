@@ -3,13 +3,14 @@
 
 #include "planet_renderer.h"
 #include "hammer_projection.h"
+#include <vector>
 
 class Map_renderer : public Planet_renderer {
 public:
 	Map_renderer ();
 
 	void set_matrix ();
-	void draw_tile (int, const Colour&);
+	void draw_tile (int);
 	void draw (const Planet&, const Quaternion&, const Planet_colours&);
 	void change_scale (const Vector2&, double);
 	void mouse_dragged (const Vector2&);
@@ -20,6 +21,9 @@ public:
 	double max_scale () const;
 	double min_scale () const;
  	void update_geometry ();
+	// tile under a screen position, -1 outside the map
+	int tile_at (const Vector2&);
+	void update_tile_ids ();
 
 	Vector2 screen_to_map_position (const Vector2&, double) const;
 	Vector2 map_to_screen_position (const Vector2&, double) const;
@@ -29,6 +33,11 @@ public:
 	Hammer_projection projection;
 	Vector2 camera_position;
 	bool geometry_updated;
+	// tile of each pixel, rendered on demand and kept until the view or geometry changes
+	std::vector<int> tile_ids;
+	bool tile_ids_updated;
+	int tile_ids_width;
+	int tile_ids_height;
 };
 
 #endif
\ No newline at end of file
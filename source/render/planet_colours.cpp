@@ -1,24 +1,41 @@
 #include "planet_colours.h"
 #include "../planet/planet.h"
+#include <algorithm>
+#include <cstdlib>
 
 void clear_colours (Planet_colours& c) {
 	std::deque<Colour>().swap(c.tiles);
+	std::vector<float>().swap(c.topography);
+	c.seasons.clear();
+	c.attribute = nullptr;
+	c.palette = nullptr;
 }
 
 void init_colours (Planet_colours& c, const Planet& p) {
+	clear_colours(c);
 	c.tiles.resize(tile_count(p));
 }
 
+void clear_season_attributes (Planet_colours& c) {
+	if (c.attribute != &c.topography) {
+		c.attribute = nullptr;
+		c.palette = nullptr;
+	}
+	c.seasons.clear();
+}
+
 void set_colours (Planet_colours& c, const Planet& p, int mode) {
+	c.mode = mode;
 	if (mode == c.TOPOGRAPHY)
 		colour_topography(c, p);
 }
 
 void set_colours (Planet_colours& c, const Planet& p, const Season* s, int mode) {
+	c.mode = mode;
 	if (s != nullptr) {
 		if (mode == c.VEGETATION)
 			colour_vegetation(c, p, *s);
-		if (mode == c.TEMPERATURE)
+		else if (mode == c.TEMPERATURE)
 			colour_temperature(c, p, *s);
 		else if (mode == c.ARIDITY)
 			colour_aridity(c, p, *s);
@@ -30,49 +47,189 @@ void set_colours (Planet_colours& c, const Planet& p, const Season* s, int mode)
 	set_colours(c, p, mode);
 }
 
+int _season_index (const Planet& p, const Season* s) {
+	for (unsigned i=0; i<climate(p).seasons.size(); i++)
+		if (&climate(p).seasons[i] == s)
+			return i;
+	return -1;
+}
+
 void colour_topography (Planet_colours& c, const Planet& p) {
-	static const Colour water_deep = Colour(0.0, 0.0, 0.25);
-	static const Colour water = Colour(0.0, 0.12, 0.5);
-	static const Colour water_shallow = Colour(0.0, 0.4, 0.6);
+	const Colour_palette& pal = palette(c.TOPOGRAPHY);
+	if (c.topography.size() != (unsigned)tile_count(p)) {
+		c.topography.resize(tile_count(p));
+		for (const Tile& t : tiles(p)) {
+			const Terrain_tile& ter = nth_tile(terrain(p), id(t));
+			double elev = elevation(ter) - sea_level(p);
+			// ramp 0 is water, ramp 1 is land
+			c.topography[id(t)] = coordinate(pal, is_water(ter) ? 0 : 1, elev);
+		}
+	}
+	c.attribute = &c.topography;
+	c.palette = &pal;
+}
 
-	static const Colour land[6] = {
-		Colour(0.0, 0.4, 0.0),
-		Colour(0.0, 0.7, 0.0),
-		Colour(1.0, 1.0, 0.0),
-		Colour(1.0, 0.5, 0.0),
-		Colour(0.7, 0.0, 0.0),
-		Colour(0.1, 0.1, 0.1)};
-	double land_limits[7] = {-500, 0, 500, 1000, 1500, 2000, 2500};
+void colour_vegetation (Planet_colours& c, const Planet& p, const Season& s) {
+	for (const Tile& t : tiles(p))
+		c.tiles[id(t)] = vegetation_colour(p, s, id(t));
+	c.attribute = nullptr;
+	c.palette = nullptr;
+}
+
+void colour_temperature (Planet_colours& c, const Planet& p, const Season& s) {
+	c.attribute = &season_attributes(c, p, s).temperature;
+	c.palette = &palette(c.TEMPERATURE);
+}
+
+void colour_aridity (Planet_colours& c, const Planet& p, const Season& s) {
+	c.attribute = &season_attributes(c, p, s).aridity;
+	c.palette = &palette(c.ARIDITY);
+}
+
+void colour_humidity (Planet_colours& c, const Planet& p, const Season& s) {
+	c.attribute = &season_attributes(c, p, s).humidity;
+	c.palette = &palette(c.HUMIDITY);
+}
+
+void colour_precipitation (Planet_colours& c, const Planet& p, const Season& s) {
+	c.attribute = &season_attributes(c, p, s).precipitation;
+	c.palette = &palette(c.PRECIPITATION);
+}
+
+Colour tile_colour (const Planet_colours& c, int i) {
+	if (c.attribute != nullptr)
+		return colour(*c.palette, (*c.attribute)[i]);
+	return c.tiles[i];
+}
+
+// seasons apart in either direction around the year, index -1 is farther than any season
+int _season_distance (int a, int b, int seasons) {
+	if (a < 0 || b < 0)
+		return seasons;
+	int d = std::abs(a - b) % seasons;
+	return std::min(d, seasons - d);
+}
+
+// makes room for season n by dropping the cached seasons farthest from it
+void _evict_season_attributes (Planet_colours& c, int n, int seasons) {
+	while ((int)c.seasons.size() >= cached_season_attributes) {
+		auto farthest = c.seasons.begin();
+		for (auto i=c.seasons.begin(); i!=c.seasons.end(); i++)
+			if (_season_distance(i->first, n, seasons) > _season_distance(farthest->first, n, seasons))
+				farthest = i;
+		c.seasons.erase(farthest);
+	}
+}
+
+const Season_attributes& season_attributes (Planet_colours& c, const Planet& p, const Season& s) {
+	int n = _season_index(p, &s);
+	// seasons that aren't part of the planet's climate share index -1 and are never taken from the cache
+	if (n >= 0) {
+		auto found = c.seasons.find(n);
+		if (found != c.seasons.end())
+			return found->second;
+	}
+	if (c.seasons.find(n) == c.seasons.end())
+		_evict_season_attributes(c, n, climate(p).seasons.size());
+	Season_attributes& a = c.seasons[n];
+	set_season_attributes(a, p, s);
+	return a;
+}
+
+void set_season_attributes (Season_attributes& a, const Planet& p, const Season& s) {
+	const Colour_palette& temperature_palette = palette(Planet_colours::TEMPERATURE);
+	const Colour_palette& aridity_palette = palette(Planet_colours::ARIDITY);
+	const Colour_palette& humidity_palette = palette(Planet_colours::HUMIDITY);
+	const Colour_palette& precipitation_palette = palette(Planet_colours::PRECIPITATION);
+
+	a.temperature.resize(tile_count(p));
+	a.aridity.resize(tile_count(p));
+	a.humidity.resize(tile_count(p));
+	a.precipitation.resize(tile_count(p));
 	for (const Tile& t : tiles(p)) {
-		const Terrain_tile& ter = nth_tile(terrain(p), id(t));
-		double elev = elevation(ter) - sea_level(p);
-		if (is_water(ter)) {
-			if (elev < -1000) {
-				c.tiles[id(t)] = water_deep;
-			}
-			else if (elev < -500) {
-				double d = (elev+500)/(-500);
-				c.tiles[id(t)] = interpolate(water, water_deep, d);
-			}
-			else {
-				double d = elev/(-500);
-				c.tiles[id(t)] = interpolate(water_shallow, water, d);
-			}
+		const Climate_tile& climate = nth_tile(s, id(t));
+		a.temperature[id(t)] = coordinate(temperature_palette, 0, temperature(climate) - freezing_point());
+		// ramp 0 is land, ramp 1 is water
+		if (is_water(nth_tile(terrain(p), id(t)))) {
+			a.aridity[id(t)] = coordinate(aridity_palette, 1, 0);
+			a.humidity[id(t)] = coordinate(humidity_palette, 1, 0);
+			a.precipitation[id(t)] = coordinate(precipitation_palette, 1, 0);
 		}
 		else {
-			c.tiles[id(t)] = land[5];
-			for (int i=0; i<5; i++) {
-				if (elev <= land_limits[i+1]) {
-					double d = std::max(0.0, std::min(1.0, (elev - land_limits[i]) / (land_limits[i+1] - land_limits[i])));
-					c.tiles[id(t)] = interpolate(land[i], land[i+1], d);
-					break;
-				}
-			}
+			a.aridity[id(t)] = coordinate(aridity_palette, 0, aridity(climate));
+			a.humidity[id(t)] = coordinate(humidity_palette, 0, humidity(climate) / saturation_humidity(temperature(climate)));
+			a.precipitation[id(t)] = coordinate(precipitation_palette, 0, precipitation(climate));
 		}
 	}
 }
 
-void colour_vegetation (Planet_colours& c, const Planet& p, const Season& s) {
+const std::vector<float>& attribute (const Season_attributes& a, int mode) {
+	if (mode == Planet_colours::ARIDITY)
+		return a.aridity;
+	if (mode == Planet_colours::HUMIDITY)
+		return a.humidity;
+	if (mode == Planet_colours::PRECIPITATION)
+		return a.precipitation;
+	return a.temperature;
+}
+
+bool has_palette (int mode) {
+	return mode != Planet_colours::VEGETATION;
+}
+
+Colour_palette _topography_palette () {
+	Colour_palette p;
+	add_ramp(p, topography_water_colour, -1000, 0, 256);
+	add_ramp(p, topography_land_colour, -500, 2500, 256);
+	return p;
+}
+
+Colour_palette _temperature_palette () {
+	Colour_palette p;
+	add_ramp(p, temperature_colour, -50, 30, 256);
+	return p;
+}
+
+Colour_palette _aridity_palette () {
+	Colour_palette p;
+	add_ramp(p, aridity_colour, 0, 2.0, 255);
+	add_ramp(p, Colour(1.0, 1.0, 1.0));
+	return p;
+}
+
+Colour_palette _humidity_palette () {
+	Colour_palette p;
+	add_ramp(p, humidity_colour, 0, 1.0, 255);
+	add_ramp(p, Colour(1.0, 1.0, 1.0));
+	return p;
+}
+
+Colour_palette _precipitation_palette () {
+	Colour_palette p;
+	add_ramp(p, precipitation_colour, 0, 7e-8, 255);
+	add_ramp(p, Colour(1.0, 1.0, 1.0));
+	return p;
+}
+
+const Colour_palette& palette (int mode) {
+	// texel counts are kept at powers of two for older opengl versions
+	static const Colour_palette topography = _topography_palette();
+	static const Colour_palette temperature = _temperature_palette();
+	static const Colour_palette aridity = _aridity_palette();
+	static const Colour_palette humidity = _humidity_palette();
+	static const Colour_palette precipitation = _precipitation_palette();
+	if (mode == Planet_colours::TEMPERATURE)
+		return temperature;
+	if (mode == Planet_colours::ARIDITY)
+		return aridity;
+	if (mode == Planet_colours::HUMIDITY)
+		return humidity;
+	if (mode == Planet_colours::PRECIPITATION)
+		return precipitation;
+	return topography;
+}
+
+Colour vegetation_colour (const Planet& p, const Season& s, int i) {
 	static const Colour snow = Colour(1.0, 1.0, 1.0);
 	static const Colour water_deep = Colour(0.05, 0.05, 0.20);
 	static const Colour water_shallow = Colour(0.04, 0.22, 0.42);
@@ -80,26 +237,53 @@ void colour_vegetation (Planet_colours& c, const Planet& p, const Season& s) {
 	static const Colour land_high = Colour(0.1, 0.1, 0.1);
 	static const Colour vegetation = Colour(0.176, 0.32, 0.05);
 
-	for (const Tile& t : tiles(p)) {
-		if (is_water(nth_tile(terrain(p) ,id(t)))) {
-			double d = std::min(1.0f, water_depth(nth_tile(terrain(p), id(t)))/400);
-			c.tiles[id(t)] = interpolate(water_shallow, water_deep, d);
-		}
-		else {
-			auto& climate = nth_tile(s, id(t));
-			if (temperature(climate) <= freezing_point())
-				c.tiles[id(t)] = snow;
-			else {
-				double d = std::min(1.0, (elevation(nth_tile(terrain(p), id(t))) - sea_level(p))/2500);
-				Colour ground = interpolate(land_low, land_high, d);
-				double v = std::min(1.0f, aridity(climate)/1.5f);
-				c.tiles[id(t)] = interpolate(vegetation, ground, v);
-			}
+	if (is_water(nth_tile(terrain(p), i))) {
+		double d = std::min(1.0f, water_depth(nth_tile(terrain(p), i))/400);
+		return interpolate(water_shallow, water_deep, d);
+	}
+	auto& climate = nth_tile(s, i);
+	if (temperature(climate) <= freezing_point())
+		return snow;
+	double d = std::min(1.0, (elevation(nth_tile(terrain(p), i)) - sea_level(p))/2500);
+	Colour ground = interpolate(land_low, land_high, d);
+	double v = std::min(1.0f, aridity(climate)/1.5f);
+	return interpolate(vegetation, ground, v);
+}
+
+Colour topography_water_colour (double elev) {
+	static const Colour water_deep = Colour(0.0, 0.0, 0.25);
+	static const Colour water = Colour(0.0, 0.12, 0.5);
+	static const Colour water_shallow = Colour(0.0, 0.4, 0.6);
+
+	if (elev < -1000)
+		return water_deep;
+	if (elev < -500) {
+		double d = (elev+500)/(-500);
+		return interpolate(water, water_deep, d);
+	}
+	double d = elev/(-500);
+	return interpolate(water_shallow, water, d);
+}
+
+Colour topography_land_colour (double elev) {
+	static const Colour land[6] = {
+		Colour(0.0, 0.4, 0.0),
+		Colour(0.0, 0.7, 0.0),
+		Colour(1.0, 1.0, 0.0),
+		Colour(1.0, 0.5, 0.0),
+		Colour(0.7, 0.0, 0.0),
+		Colour(0.1, 0.1, 0.1)};
+	double land_limits[7] = {-500, 0, 500, 1000, 1500, 2000, 2500};
+	for (int i=0; i<5; i++) {
+		if (elev <= land_limits[i+1]) {
+			double d = std::max(0.0, std::min(1.0, (elev - land_limits[i]) / (land_limits[i+1] - land_limits[i])));
+			return interpolate(land[i], land[i+1], d);
 		}
 	}
+	return land[5];
 }
 
-void colour_temperature (Planet_colours& c, const Planet& p, const Season& s) {
+Colour temperature_colour (double temp) {
 	static const Colour col[8] = {
 		Colour(1.0, 1.0, 1.0),
 		Colour(0.7, 0, 0.5),
@@ -111,97 +295,60 @@ void colour_temperature (Planet_colours& c, const Planet& p, const Season& s) {
 		Colour(0.45, 0, 0)};
 	static float limits[8] = {-50, -35, -20, -10, 0, 10, 20, 30};
 
-	for (const Tile& t : tiles(p)) {
-		float temp = temperature(nth_tile(s, id(t))) - freezing_point();
-		if (temp <= limits[0])
-			c.tiles[id(t)] = col[0];
-		else if (temp >= limits[7])
-			c.tiles[id(t)] = col[7];
-		else {
-			for (int i=0; i<7; i++) {
-				if (temp >= limits[i] && temp < limits[i+1]) {
-					double d = (temp - limits[i]) / (limits[i+1] - limits[i]);
-					c.tiles[id(t)] = interpolate(col[i], col[i+1], d);
-					break;
-				}
-			}
+	if (temp <= limits[0])
+		return col[0];
+	if (temp >= limits[7])
+		return col[7];
+	for (int i=0; i<7; i++) {
+		if (temp >= limits[i] && temp < limits[i+1]) {
+			double d = (temp - limits[i]) / (limits[i+1] - limits[i]);
+			return interpolate(col[i], col[i+1], d);
 		}
 	}
+	return col[7];
 }
 
-void colour_aridity (Planet_colours& c, const Planet& p, const Season& s) {
-	static const Colour water = Colour(1.0, 1.0, 1.0);
-
+Colour aridity_colour (double ar) {
 	static const Colour col[4] = {
 		Colour(1.0, 0.0, 0.0),
 		Colour(1.0, 1.0, 0.0),
 		Colour(0.0, 1.0, 0.0),
 		Colour(0.0, 0.5, 0.0)};
-		
 	float limits[4] = {2.0f, 1.0f, 0.5f, 0.0f};
 
-	for (const Tile& t : tiles(p)) {
-		if (is_water(nth_tile(terrain(p) ,id(t))))
-			c.tiles[id(t)] = water;
-		else {
-			float ar = aridity(nth_tile(s, id(t)));
-			c.tiles[id(t)] = col[3];
-			for (int i=1; i<4; i++) {
-				if (ar > limits[i]) {
-					double d = std::min(1.0f, (ar - limits[i]) / (limits[i-1] - limits[i]));
-					c.tiles[id(t)] = interpolate(col[i], col[i-1], d);
-					break;
-				}
-			}
+	for (int i=1; i<4; i++) {
+		if (ar > limits[i]) {
+			double d = std::min(1.0, (ar - limits[i]) / (limits[i-1] - limits[i]));
+			return interpolate(col[i], col[i-1], d);
 		}
 	}
+	return col[3];
 }
 
-void colour_humidity (Planet_colours& c, const Planet& p, const Season& s) {
-	static const Colour water = Colour(1.0, 1.0, 1.0);
+Colour humidity_colour (double h) {
 	static const Colour land_dry = Colour(1.0, 1.0, 0.5);
 	static const Colour land_mid = Colour(1.0, 1.0, 0.0);
 	static const Colour land_humid = Colour(0.0, 0.7, 0.0);
-	
-	for (const Tile& t : tiles(p)) {
-		double h = humidity(nth_tile(s, id(t))) / saturation_humidity(temperature(nth_tile(s, id(t))));
-		if (is_water(nth_tile(terrain(p), id(t)))) {
-			c.tiles[id(t)] = water;
-		}
-		else {
-			if (h <= 0.5) {
-				double d = h / 0.5;
-				c.tiles[id(t)] = interpolate(land_dry, land_mid, d);
-			}
-			else {
-				double d = (h-0.5)/0.5;
-				c.tiles[id(t)] = interpolate(land_mid, land_humid, d);
-			}
-		}
+
+	if (h <= 0.5) {
+		double d = h / 0.5;
+		return interpolate(land_dry, land_mid, d);
 	}
+	double d = (h-0.5)/0.5;
+	return interpolate(land_mid, land_humid, d);
 }
 
-void colour_precipitation (Planet_colours& c, const Planet& p, const Season& s) {
-	static const Colour water = Colour(1.0, 1.0, 1.0);
+Colour precipitation_colour (double prec) {
 	static const Colour dry = Colour(1.0, 1.0, 0.5);
 	static const Colour medium = Colour(0.0, 1.0, 0.0);
 	static const Colour wet = Colour(0.0, 0.0, 1.0);
+	double high = 7e-8;
+	double low = high/10;
 
-	for (const Tile& t : tiles(p)) {
-		double high = 7e-8;
-		double low = high/10;
-		if (is_water(nth_tile(terrain(p), id(t))))
-			c.tiles[id(t)] = water;
-		else {
-			float prec = precipitation(nth_tile(s, id(t)));
-			if (prec < low) {
-				double d = prec / low;
-				c.tiles[id(t)] = interpolate(dry, medium, d);
-			}
-			else {
-				double d = std::min(1.0, (prec - low) / (high - low));
-				c.tiles[id(t)] = interpolate(medium, wet, d);
-			}
-		}
+	if (prec < low) {
+		double d = prec / low;
+		return interpolate(dry, medium, d);
 	}
+	double d = std::min(1.0, (prec - low) / (high - low));
+	return interpolate(medium, wet, d);
 }
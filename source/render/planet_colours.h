@@ -2,21 +2,52 @@
 #define planet_colours_h
 
 #include <deque>
+#include <vector>
+#include <map>
 #include "colour.h"
+#include "colour_palette.h"
 class Planet;
 class Season;
 
+// seasons whose palette coordinates are kept, the ones nearest the season last coloured,
+// so stepping back and forth doesn't recalculate them
+const int cached_season_attributes = 3;
+
+// palette coordinates of a season, calculated once and reused when switching modes or seasons
+class Season_attributes {
+public:
+	Season_attributes () {}
+
+	std::vector<float> temperature;
+	std::vector<float> aridity;
+	std::vector<float> humidity;
+	std::vector<float> precipitation;
+};
+
 class Planet_colours {
 public:
-	Planet_colours () {}
+	Planet_colours () :
+		mode (TOPOGRAPHY), attribute (nullptr), palette (nullptr) {}
 
+	// used by modes without a palette
 	std::deque<Colour> tiles;
 
+	int mode;
+	// per tile palette coordinate of the active mode, nullptr when tiles are used
+	const std::vector<float>* attribute;
+	const Colour_palette* palette;
+
+	std::vector<float> topography;
+	// by season index, at most cached_season_attributes of them
+	std::map<int, Season_attributes> seasons;
+
 	enum {TOPOGRAPHY, VEGETATION, TEMPERATURE, ARIDITY, HUMIDITY, PRECIPITATION};
 };
 
 void clear_colours (Planet_colours&);
 void init_colours (Planet_colours&, const Planet&);
+// drops cached season attributes, needed whenever the climate changes
+void clear_season_attributes (Planet_colours&);
 void set_colours (Planet_colours&, const Planet&, int);
 void set_colours (Planet_colours&, const Planet&, const Season*, int);
 void colour_topography (Planet_colours&, const Planet&);
@@ -26,4 +57,24 @@ void colour_aridity (Planet_colours&, const Planet&, const Season&);
 void colour_humidity (Planet_colours&, const Planet&, const Season&);
 void colour_precipitation (Planet_colours&, const Planet&, const Season&);
 
-#endif
\ No newline at end of file
+// colour of a tile, looked up in the palette when one is active
+Colour tile_colour (const Planet_colours&, int);
+
+bool has_palette (int mode);
+const Colour_palette& palette (int mode);
+// cached by the season's index in the planet's climate
+const Season_attributes& season_attributes (Planet_colours&, const Planet&, const Season&);
+void set_season_attributes (Season_attributes&, const Planet&, const Season&);
+// attribute of a season colour mode with a palette
+const std::vector<float>& attribute (const Season_attributes&, int mode);
+
+Colour vegetation_colour (const Planet&, const Season&, int);
+
+Colour topography_water_colour (double);
+Colour topography_land_colour (double);
+Colour temperature_colour (double);
+Colour aridity_colour (double);
+Colour humidity_colour (double);
+Colour precipitation_colour (double);
+
+#endif
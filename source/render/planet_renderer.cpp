@@ -1,4 +1,9 @@
 #include "planet_renderer.h"
+#include "planet_colours.h"
+
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
 
 Planet_renderer::Planet_renderer () {
 	default_size = 600;
@@ -21,3 +26,33 @@ void Planet_renderer::mouse_dragged (const Vector2&) {}
 Vector3 Planet_renderer::to_coordinates (const Vector2&) const {
 	return Vector3();
 }
+
+void Planet_renderer::bind_colours (const Planet_colours& colours) {
+	if (colours.attribute == nullptr)
+		return;
+	auto found = palette_textures.find(colours.palette);
+	if (found == palette_textures.end()) {
+		GLuint texture;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_1D, texture);
+		glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB, colours.palette->texels.size(), 0, GL_RGB, GL_FLOAT, &colours.palette->texels[0]);
+		found = palette_textures.insert(std::make_pair(colours.palette, texture)).first;
+	}
+	glBindTexture(GL_TEXTURE_1D, found->second);
+	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+	glEnable(GL_TEXTURE_1D);
+}
+
+void Planet_renderer::set_tile_colour (const Planet_colours& colours, int i) {
+	if (colours.attribute != nullptr)
+		glTexCoord1f((*colours.attribute)[i]);
+	else
+		glColor3f(colours.tiles[i]);
+}
+
+void Planet_renderer::unbind_colours () {
+	glDisable(GL_TEXTURE_1D);
+}
@@ -2,13 +2,16 @@
 #define planet_renderer_h
 
 #include <QGLWidget>
+#include <map>
 #include "../math/vector2.h"
 #include "../math/vector3.h"
 #include "colour.h"
+#include "render_statistics.h"
 class Planet;
 class Quaternion;
 
 class Planet_colours;
+class Colour_palette;
 
 class Planet_renderer {
 public:
@@ -20,14 +23,22 @@ public:
 	virtual Vector3 to_coordinates (const Vector2&) const;
 	virtual void draw (const Planet&, const Quaternion&, const Planet_colours&) = 0;
 
+	// enables the palette texture of the colours, if any
+	void bind_colours (const Planet_colours&);
+	void set_tile_colour (const Planet_colours&, int);
+	void unbind_colours ();
+
 	int width;
 	int height;
 	double default_size;
 	double scale;
+	Render_statistics statistics;
+	// palettes are uploaded once and only bound afterwards
+	std::map<const Colour_palette*, GLuint> palette_textures;
 };
 
 inline void glVertex2f (const Vector2& v) {glVertex2f(v.x, v.y);}
 inline void glVertex3f (const Vector3& v) {glVertex3f(v.x, v.y, v.z);}
 inline void glColor3f (const Colour& c) {glColor3f(c.r, c.g, c.b);}
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,52 @@
+#include "render_statistics.h"
+#include <algorithm>
+#include <sstream>
+
+const unsigned frame_history = 240;
+
+void begin_frame (Render_statistics& s) {
+	s.frame_tiles = 0;
+	s.frame_vertices = 0;
+}
+
+void end_frame (Render_statistics& s, double seconds) {
+	if (s.frame_times.size() < frame_history)
+		s.frame_times.push_back(seconds);
+	else
+		s.frame_times[s.frames % frame_history] = seconds;
+	s.frames++;
+	s.tiles = s.frame_tiles;
+	s.vertices = s.frame_vertices;
+}
+
+void count_primitive (Render_statistics& s, int vertices) {
+	s.frame_tiles++;
+	s.frame_vertices += vertices;
+}
+
+void set_colour_update_time (Render_statistics& s, double seconds) {
+	s.colour_update_time = seconds;
+}
+
+double frame_time_percentile (const Render_statistics& s, double fraction) {
+	if (s.frame_times.size() == 0)
+		return 0.0;
+	std::vector<double> times = s.frame_times;
+	int n = std::min((int)times.size()-1, std::max(0, (int)(fraction * times.size())));
+	std::nth_element(times.begin(), times.begin()+n, times.end());
+	return times[n];
+}
+
+std::string summary (const Render_statistics& s) {
+	std::ostringstream text;
+	text.precision(3);
+	text << std::fixed
+		<< "frames " << s.frames
+		<< "  frame ms p50 " << 1000*frame_time_percentile(s, 0.5)
+		<< " p95 " << 1000*frame_time_percentile(s, 0.95)
+		<< " p99 " << 1000*frame_time_percentile(s, 0.99)
+		<< "  primitives " << s.tiles
+		<< "  vertices " << s.vertices
+		<< "  colour update ms " << 1000*s.colour_update_time;
+	return text.str();
+}
@@ -0,0 +1,34 @@
+#ifndef render_statistics_h
+#define render_statistics_h
+
+#include <string>
+#include <vector>
+
+// frame times and submitted primitives of a renderer, over the last frames drawn
+class Render_statistics {
+public:
+	Render_statistics () :
+		frames (0), frame_tiles (0), frame_vertices (0), tiles (0), vertices (0), colour_update_time (0) {}
+
+	// seconds, ring buffer of the latest frames
+	std::vector<double> frame_times;
+	int frames;
+	// counted by the renderer while drawing
+	int frame_tiles;
+	int frame_vertices;
+	// totals of the last finished frame
+	int tiles;
+	int vertices;
+	double colour_update_time;
+};
+
+void begin_frame (Render_statistics&);
+void end_frame (Render_statistics&, double seconds);
+void count_primitive (Render_statistics&, int vertices);
+void set_colour_update_time (Render_statistics&, double seconds);
+
+// frame time in seconds below which the given fraction of recent frames fall
+double frame_time_percentile (const Render_statistics&, double);
+std::string summary (const Render_statistics&);
+
+#endif
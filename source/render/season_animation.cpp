@@ -0,0 +1,101 @@
+#include "season_animation.h"
+#include <cmath>
+#include "../planet/planet.h"
+#include "../planet/climate/climate.h"
+#include "../io/season_codec.h"
+#include "../thread/parallel.h"
+
+Season_animation::~Season_animation () {
+	stop_animation(*this);
+}
+
+void start_animation (Season_animation& a, const Planet& p, int mode, const Compressed_climate* compressed) {
+	stop_animation(a);
+	a.mode = mode;
+	a.compressed = compressed;
+	a.palette = has_palette(mode) ? &palette(mode) : nullptr;
+	a.attributes.clear();
+	a.colours.clear();
+	if (a.palette)
+		a.attributes.resize(season_count(p));
+	else
+		a.colours.resize(season_count(p));
+	a.ready = 0;
+	a.cancelled = false;
+	const Planet* planet = &p;
+	a.worker = std::thread([&a, planet] () {
+		Season_decoder decoder;
+		Season decoded;
+		for (int i=0; i<season_count(a) && !a.cancelled; i++) {
+			if (!a.compressed)
+				_compute_season(a, *planet, nth_season(*planet, i), i);
+			else if (decode_season(decoder, *a.compressed, i, decoded))
+				_compute_season(a, *planet, decoded, i);
+			else
+				break;
+			a.ready = i+1;
+		}
+	});
+}
+
+void stop_animation (Season_animation& a) {
+	a.cancelled = true;
+	if (a.worker.joinable())
+		a.worker.join();
+}
+
+int season_count (const Season_animation& a) {
+	return a.palette ? a.attributes.size() : a.colours.size();
+}
+
+bool is_complete (const Season_animation& a) {
+	return season_count(a) > 0 && a.ready == season_count(a);
+}
+
+bool set_frame (Planet_colours& c, Season_animation& a, double time) {
+	int count = season_count(a);
+	if (count == 0)
+		return false;
+	double t = std::fmod(time, (double)count);
+	if (t < 0)
+		t += count;
+	int first = std::min(count-1, (int)t);
+	int second = (first+1) % count;
+	float d = t - first;
+	if (first >= a.ready || second >= a.ready)
+		return false;
+
+	c.mode = a.mode;
+	if (a.palette) {
+		const std::vector<float>& from = attribute(a.attributes[first], a.mode);
+		const std::vector<float>& to = attribute(a.attributes[second], a.mode);
+		a.frame.resize(from.size());
+		for (unsigned i=0; i<from.size(); i++)
+			a.frame[i] = from[i] + d*(to[i] - from[i]);
+		c.attribute = &a.frame;
+		c.palette = a.palette;
+	}
+	else {
+		const std::vector<Colour>& from = a.colours[first];
+		const std::vector<Colour>& to = a.colours[second];
+		c.tiles.resize(from.size());
+		for (unsigned i=0; i<from.size(); i++)
+			c.tiles[i] = interpolate(from[i], to[i], d);
+		c.attribute = nullptr;
+		c.palette = nullptr;
+	}
+	return true;
+}
+
+void _compute_season (Season_animation& a, const Planet& p, const Season& s, int n) {
+	if (a.palette) {
+		set_season_attributes(a.attributes[n], p, s);
+		return;
+	}
+	std::vector<Colour>& colours = a.colours[n];
+	colours.resize(tile_count(p));
+	parallel_for(0, tile_count(p), [&] (int first, int last) {
+		for (int i=first; i<last; i++)
+			colours[i] = vegetation_colour(p, s, i);
+	});
+}
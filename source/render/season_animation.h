@@ -0,0 +1,49 @@
+#ifndef season_animation_h
+#define season_animation_h
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include "colour.h"
+#include "planet_colours.h"
+class Planet;
+class Season;
+class Compressed_climate;
+
+// colour buffers of every season in one colour mode, computed on a worker thread
+// and blended into Planet_colours during playback
+class Season_animation {
+public:
+	Season_animation () :
+		mode (Planet_colours::VEGETATION), palette (nullptr), compressed (nullptr), ready (0), cancelled (false) {}
+	~Season_animation ();
+
+	int mode;
+	const Colour_palette* palette;
+	// when set, seasons are decoded from it one at a time instead of read from the planet
+	const Compressed_climate* compressed;
+	// palette coordinates per season, used by modes with a palette
+	std::vector<Season_attributes> attributes;
+	// tile colours per season, used by modes without a palette
+	std::vector<std::vector<Colour>> colours;
+	// number of seasons computed so far, seasons are completed in order
+	std::atomic<int> ready;
+	std::atomic<bool> cancelled;
+	std::thread worker;
+	// blended palette coordinates of the current frame
+	std::vector<float> frame;
+};
+
+// the planet and compressed climate must stay unchanged until the animation is stopped
+void start_animation (Season_animation&, const Planet&, int mode, const Compressed_climate* compressed = nullptr);
+void stop_animation (Season_animation&);
+int season_count (const Season_animation&);
+bool is_complete (const Season_animation&);
+
+// sets colours to the state at time, measured in seasons and wrapping around the year,
+// blending the two nearest seasons. returns false if they are not computed yet
+bool set_frame (Planet_colours&, Season_animation&, double time);
+
+void _compute_season (Season_animation&, const Planet&, const Season&, int);
+
+#endif
@@ -0,0 +1,159 @@
+#include "software_renderer.h"
+#include "hammer_projection.h"
+#include "grid_vectors.h"
+#include "planet_colours.h"
+#include "image.h"
+#include "../planet/planet.h"
+#include "../math/matrix3.h"
+#include "../thread/parallel.h"
+#include <algorithm>
+#include <cmath>
+
+void _set_bounds (Raster_polygon& p) {
+	p.top = p.points[0].y;
+	p.bottom = p.points[0].y;
+	for (int i=1; i<p.count; i++) {
+		p.top = std::min(p.top, p.points[i].y);
+		p.bottom = std::max(p.bottom, p.points[i].y);
+	}
+}
+
+void map_geometry (Raster_geometry& g, const Hammer_projection& proj, int width, int height) {
+	map_geometry(g, proj, width, height, Vector2(-hammer_width(), -hammer_height()), Vector2(hammer_width(), hammer_height()));
+}
+
+void map_geometry (Raster_geometry& g, const Hammer_projection& proj, int width, int height, const Vector2& bottom_left, const Vector2& top_right) {
+	g.width = width;
+	g.height = height;
+	g.polygons.resize(proj.tiles.size());
+	double x_scale = width / (top_right.x - bottom_left.x);
+	double y_scale = height / (top_right.y - bottom_left.y);
+	parallel_for(0, proj.tiles.size(), [&](int first, int last) {
+		for (int i=first; i<last; i++) {
+			Raster_polygon& p = g.polygons[i];
+			p.tile = i;
+			p.count = 6;
+			for (int k=0; k<6; k++) {
+				const Vector2& c = proj.tiles[i].corners[k];
+				p.points[k] = Vector2((c.x - bottom_left.x) * x_scale, (top_right.y - c.y) * y_scale);
+			}
+			_set_bounds(p);
+		}
+	});
+}
+
+double _signed_area (const Raster_polygon& p) {
+	double a = 0.0;
+	for (int i=0; i<p.count; i++) {
+		const Vector2& u = p.points[i];
+		const Vector2& v = p.points[(i+1)%p.count];
+		a += u.x*v.y - v.x*u.y;
+	}
+	return 0.5*a;
+}
+
+void globe_geometry (Raster_geometry& g, const Planet& planet, const Quaternion& q, int width, int height) {
+	g.width = width;
+	g.height = height;
+	g.polygons.clear();
+	Matrix3 m = matrix3(q);
+	double radius = 0.5 * std::min(width, height);
+	std::vector<Raster_polygon> polygons(tile_count(planet));
+	std::vector<char> visible(tile_count(planet), 0);
+	Vector3_array rotated;
+	rotated_corners(rotated, planet, m);
+	parallel_for(0, tile_count(planet), [&](int first, int last) {
+		for (int i=first; i<last; i++) {
+			const Tile* t = nth_tile(planet, i);
+			Raster_polygon& p = polygons[i];
+			p.tile = i;
+			p.count = edge_count(t);
+			for (int k=0; k<p.count; k++) {
+				int c = id(nth_corner(t, k));
+				p.points[k] = Vector2(rotated.x[c], rotated.y[c]);
+			}
+			// same culling as the opengl renderer, counter clockwise faces the viewer
+			if (_signed_area(p) <= 0)
+				continue;
+			visible[i] = 1;
+			for (int k=0; k<p.count; k++)
+				p.points[k] = Vector2(0.5*width + p.points[k].x*radius, 0.5*height - p.points[k].y*radius);
+			_set_bounds(p);
+		}
+	});
+	for (int i=0; i<tile_count(planet); i++)
+		if (visible[i])
+			g.polygons.push_back(polygons[i]);
+}
+
+// pixel rows whose centres are covered by the polygon
+void _row_range (const Raster_polygon& p, int height, int& first, int& last) {
+	first = std::max(0, (int)std::ceil(p.top - 0.5));
+	last = std::min(height, (int)std::ceil(p.bottom - 0.5));
+}
+
+void scan_geometry (const Raster_geometry& g, const std::function<void (int, int, int, int)>& f) {
+	const int band_height = 32;
+	int bands = (g.height + band_height - 1) / band_height;
+	std::vector<std::vector<int> > band_polygons(bands);
+	for (unsigned i=0; i<g.polygons.size(); i++) {
+		int first, last;
+		_row_range(g.polygons[i], g.height, first, last);
+		if (first >= last)
+			continue;
+		for (int b = first/band_height; b <= (last-1)/band_height; b++)
+			band_polygons[b].push_back(i);
+	}
+	parallel_for(0, bands, 1, [&](int first_band, int last_band) {
+		for (int b=first_band; b<last_band; b++) {
+			for (int i : band_polygons[b]) {
+				const Raster_polygon& p = g.polygons[i];
+				int first, last;
+				_row_range(p, g.height, first, last);
+				first = std::max(first, b*band_height);
+				last = std::min(last, (b+1)*band_height);
+				for (int row=first; row<last; row++) {
+					double y = row + 0.5;
+					double left = g.width;
+					double right = 0;
+					bool found = false;
+					for (int k=0; k<p.count; k++) {
+						const Vector2& u = p.points[k];
+						const Vector2& v = p.points[(k+1)%p.count];
+						if ((u.y <= y && y < v.y) || (v.y <= y && y < u.y)) {
+							double x = u.x + (y - u.y) * (v.x - u.x) / (v.y - u.y);
+							left = found ? std::min(left, x) : x;
+							right = found ? std::max(right, x) : x;
+							found = true;
+						}
+					}
+					if (!found)
+						continue;
+					int x_first = std::max(0, (int)std::ceil(left - 0.5));
+					int x_last = std::min(g.width, (int)std::ceil(right - 0.5));
+					if (x_first < x_last)
+						f(p.tile, row, x_first, x_last);
+				}
+			}
+		}
+	});
+}
+
+void draw_tiles (Image& image, const Raster_geometry& g, const Planet_colours& colours) {
+	std::vector<Colour> tile_colours;
+	for (const Raster_polygon& p : g.polygons) {
+		if (p.tile >= (int)tile_colours.size())
+			tile_colours.resize(p.tile+1);
+		tile_colours[p.tile] = tile_colour(colours, p.tile);
+	}
+	scan_geometry(g, [&](int tile, int row, int first, int last) {
+		set_pixels(image, row, first, last, tile_colours[tile]);
+	});
+}
+
+Quaternion globe_rotation (double latitude, double longitude) {
+	Quaternion axis_rotation = Quaternion(Vector3(1,0,0), Vector3(0,0,1)) * Quaternion(default_axis(), Vector3(0,1,0));
+	Quaternion longitude_rotation = Quaternion(Vector3(0,1,0), -longitude);
+	Quaternion latitude_rotation = Quaternion(Vector3(1,0,0), -latitude);
+	return latitude_rotation * longitude_rotation * axis_rotation;
+}
@@ -0,0 +1,52 @@
+#ifndef software_renderer_h
+#define software_renderer_h
+
+#include <vector>
+#include <functional>
+#include "../math/vector2.h"
+#include "../math/quaternion.h"
+class Planet;
+class Planet_colours;
+class Hammer_projection;
+class Image;
+
+// tile outline in pixel coordinates
+class Raster_polygon {
+public:
+	Raster_polygon () :
+		tile (0), count (0), top (0), bottom (0) {}
+
+	int tile;
+	int count;
+	Vector2 points[6];
+	float top;
+	float bottom;
+};
+
+class Raster_geometry {
+public:
+	Raster_geometry () :
+		width (0), height (0) {}
+
+	int width;
+	int height;
+	std::vector<Raster_polygon> polygons;
+};
+
+// whole map, stretched to the image
+void map_geometry (Raster_geometry&, const Hammer_projection&, int width, int height);
+// part of the map between two corners in map coordinates
+void map_geometry (Raster_geometry&, const Hammer_projection&, int width, int height, const Vector2& bottom_left, const Vector2& top_right);
+// front facing tiles of the globe rotated by the quaternion, fitted to the image
+void globe_geometry (Raster_geometry&, const Planet&, const Quaternion&, int width, int height);
+
+// calls f(tile, row, first, last) for every run of pixels whose centres lie inside a tile,
+// rows are split among threads and each row is only visited by one thread
+void scan_geometry (const Raster_geometry&, const std::function<void (int, int, int, int)>&);
+
+void draw_tiles (Image&, const Raster_geometry&, const Planet_colours&);
+
+// view rotation of the globe at the given latitude and longitude, matching Globe_renderer
+Quaternion globe_rotation (double latitude, double longitude);
+
+#endif
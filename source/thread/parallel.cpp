@@ -0,0 +1,59 @@
+#include "parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static thread_local bool worker_thread = false;
+static thread_local int limit = 0;
+
+int thread_count () {
+	static const int count = std::max(1u, std::thread::hardware_concurrency());
+	return count;
+}
+
+void parallel_for (int begin, int end, int block_size, const std::function<void (int, int)>& f) {
+	if (end <= begin)
+		return;
+	block_size = std::max(1, block_size);
+	int blocks = (end - begin + block_size - 1) / block_size;
+	int threads = worker_thread ? 1 : std::min(limit > 0 ? limit : thread_count(), blocks);
+	if (threads == 1) {
+		for (int i=begin; i<end; i+=block_size)
+			f(i, std::min(end, i+block_size));
+		return;
+	}
+	std::atomic<int> next_block(0);
+	auto work = [&]() {
+		worker_thread = true;
+		for (int b = next_block++; b < blocks; b = next_block++) {
+			int first = begin + b*block_size;
+			f(first, std::min(end, first+block_size));
+		}
+	};
+	std::vector<std::thread> workers;
+	for (int i=1; i<threads; i++)
+		workers.push_back(std::thread(work));
+	work();
+	worker_thread = false;
+	for (auto& w : workers)
+		w.join();
+}
+
+void parallel_for (int begin, int end, const std::function<void (int, int)>& f) {
+	// a few blocks per thread evens out uneven work
+	int blocks = 4*thread_count();
+	parallel_for(begin, end, std::max(1, (end - begin + blocks - 1) / blocks), f);
+}
+
+void mark_worker_thread () {
+	worker_thread = true;
+}
+
+int thread_limit () {
+	return limit;
+}
+
+void set_thread_limit (int threads) {
+	limit = std::max(0, threads);
+}
@@ -0,0 +1,22 @@
+#ifndef parallel_h
+#define parallel_h
+
+#include <functional>
+
+// number of worker threads used for parallel loops
+int thread_count ();
+
+// splits [begin, end) into blocks of at most block_size and calls f(first, last) for each,
+// blocks are handed out to thread_count() threads as they become free
+void parallel_for (int begin, int end, int block_size, const std::function<void (int, int)>&);
+// as above, with blocks sized to spread the range evenly
+void parallel_for (int begin, int end, const std::function<void (int, int)>&);
+
+// loops started from a worker thread run serially on it, so nested parallelism doesn't oversubscribe
+void mark_worker_thread ();
+
+// most threads used by loops started from the calling thread, 0 for thread_count()
+int thread_limit ();
+void set_thread_limit (int);
+
+#endif
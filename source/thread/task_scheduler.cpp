@@ -0,0 +1,98 @@
+#include "task_scheduler.h"
+#include "parallel.h"
+
+// scheduler and queue of the calling thread when it is a worker
+static thread_local Task_scheduler* current_scheduler = nullptr;
+static thread_local int current_worker = -1;
+
+Task_scheduler::Task_scheduler (int threads) :
+	queued (0), pending (0), next_queue (0), steals (0), stopping (false) {
+	if (threads <= 0)
+		threads = thread_count();
+	for (int i=0; i<threads; i++)
+		queues.push_back(std::unique_ptr<Task_queue>(new Task_queue()));
+	for (int i=0; i<threads; i++)
+		workers.push_back(std::thread(_run_scheduler_worker, std::ref(*this), i));
+}
+
+Task_scheduler::~Task_scheduler () {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	task_added.notify_all();
+	for (auto& w : workers)
+		w.join();
+}
+
+int worker_count (const Task_scheduler& s) {
+	return s.workers.size();
+}
+
+void submit (Task_scheduler& s, const std::function<void ()>& task) {
+	int queue = current_scheduler == &s ?
+		current_worker :
+		s.next_queue++ % s.queues.size();
+	s.pending++;
+	s.queued++;
+	{
+		std::lock_guard<std::mutex> lock(s.queues[queue]->mutex);
+		s.queues[queue]->tasks.push_back(task);
+	}
+	// taking the lock orders this against a worker checking queued before it sleeps
+	std::lock_guard<std::mutex> lock(s.mutex);
+	s.task_added.notify_one();
+}
+
+void wait (Task_scheduler& s) {
+	std::unique_lock<std::mutex> lock(s.mutex);
+	s.task_done.wait(lock, [&s] () {return s.pending == 0;});
+}
+
+void _run_scheduler_worker (Task_scheduler& s, int worker) {
+	mark_worker_thread();
+	current_scheduler = &s;
+	current_worker = worker;
+	std::function<void ()> task;
+	while (true) {
+		if (_take_task(s, worker, task)) {
+			task();
+			task = nullptr;
+			if (--s.pending == 0) {
+				std::lock_guard<std::mutex> lock(s.mutex);
+				s.task_done.notify_all();
+			}
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(s.mutex);
+		s.task_added.wait(lock, [&s] () {return s.stopping || s.queued > 0;});
+		if (s.stopping && s.queued == 0)
+			return;
+	}
+}
+
+bool _take_task (Task_scheduler& s, int worker, std::function<void ()>& task) {
+	{
+		Task_queue& own = *s.queues[worker];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty()) {
+			task = own.tasks.back();
+			own.tasks.pop_back();
+			s.queued--;
+			return true;
+		}
+	}
+	int count = s.queues.size();
+	for (int i=1; i<count; i++) {
+		Task_queue& other = *s.queues[(worker + i) % count];
+		std::lock_guard<std::mutex> lock(other.mutex);
+		if (!other.tasks.empty()) {
+			task = other.tasks.front();
+			other.tasks.pop_front();
+			s.queued--;
+			s.steals++;
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,55 @@
+#ifndef task_scheduler_h
+#define task_scheduler_h
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+class Task_queue {
+public:
+	Task_queue () {}
+
+	std::mutex mutex;
+	std::deque<std::function<void ()>> tasks;
+};
+
+// work stealing scheduler. every worker has its own queue: tasks submitted from a worker go
+// to the back of its queue and it runs its newest task first, so a task's follow-up work
+// runs next on the same thread. a worker with nothing left takes the oldest task of another.
+// suits tasks whose cost varies widely and that spawn more tasks
+class Task_scheduler {
+public:
+	// thread_count() workers when threads is 0
+	Task_scheduler (int threads = 0);
+	~Task_scheduler ();
+
+	std::vector<std::unique_ptr<Task_queue>> queues;
+	std::vector<std::thread> workers;
+	// guards sleeping and waking, queues have their own locks
+	std::mutex mutex;
+	std::condition_variable task_added;
+	std::condition_variable task_done;
+	// tasks in a queue, not yet started
+	std::atomic<int> queued;
+	// tasks queued or running
+	std::atomic<int> pending;
+	// queue of the next task submitted from outside the workers
+	std::atomic<unsigned> next_queue;
+	std::atomic<long> steals;
+	bool stopping;
+};
+
+int worker_count (const Task_scheduler&);
+void submit (Task_scheduler&, const std::function<void ()>&);
+// blocks until every submitted task, including those submitted by tasks, has finished
+void wait (Task_scheduler&);
+
+void _run_scheduler_worker (Task_scheduler&, int);
+bool _take_task (Task_scheduler&, int, std::function<void ()>&);
+
+#endif
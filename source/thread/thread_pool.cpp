@@ -0,0 +1,55 @@
+#include "thread_pool.h"
+#include "parallel.h"
+
+Thread_pool::Thread_pool (int threads) :
+	pending (0), stopping (false) {
+	if (threads <= 0)
+		threads = thread_count();
+	for (int i=0; i<threads; i++)
+		workers.push_back(std::thread(_run_worker, std::ref(*this)));
+}
+
+Thread_pool::~Thread_pool () {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	task_added.notify_all();
+	for (auto& w : workers)
+		w.join();
+}
+
+int worker_count (const Thread_pool& pool) {
+	return pool.workers.size();
+}
+
+void submit (Thread_pool& pool, const std::function<void ()>& task) {
+	{
+		std::lock_guard<std::mutex> lock(pool.mutex);
+		pool.tasks.push_back(task);
+		pool.pending++;
+	}
+	pool.task_added.notify_one();
+}
+
+void wait (Thread_pool& pool) {
+	std::unique_lock<std::mutex> lock(pool.mutex);
+	pool.task_done.wait(lock, [&pool] () {return pool.pending == 0;});
+}
+
+void _run_worker (Thread_pool& pool) {
+	mark_worker_thread();
+	std::unique_lock<std::mutex> lock(pool.mutex);
+	while (true) {
+		pool.task_added.wait(lock, [&pool] () {return pool.stopping || !pool.tasks.empty();});
+		if (pool.tasks.empty())
+			return;
+		std::function<void ()> task = pool.tasks.front();
+		pool.tasks.pop_front();
+		lock.unlock();
+		task();
+		lock.lock();
+		if (--pool.pending == 0)
+			pool.task_done.notify_all();
+	}
+}
@@ -0,0 +1,35 @@
+#ifndef thread_pool_h
+#define thread_pool_h
+
+#include <deque>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// fixed set of worker threads running queued tasks in submission order
+class Thread_pool {
+public:
+	// thread_count() workers when threads is 0
+	Thread_pool (int threads = 0);
+	~Thread_pool ();
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void ()>> tasks;
+	std::mutex mutex;
+	std::condition_variable task_added;
+	std::condition_variable task_done;
+	// tasks queued or running
+	int pending;
+	bool stopping;
+};
+
+int worker_count (const Thread_pool&);
+void submit (Thread_pool&, const std::function<void ()>&);
+// blocks until every submitted task has finished
+void wait (Thread_pool&);
+
+void _run_worker (Thread_pool&);
+
+#endif